@@ -0,0 +1,95 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <string.h>
+#include "analytics.h"
+
+/* Every cell value falls in [-8, 9], so counting each value is enough:
+ * owners, histogram, free cells and free reward all derive from the counts.
+ */
+#define STATS_MIN_VALUE (-(STATS_MAX_OWNERS - 1))
+#define STATS_BINS (STATS_MAX_REWARD - STATS_MIN_VALUE + 1)
+#define STATS_BLOCK 16         // Cells per block: one byte lane each
+#define STATS_FLUSH_BLOCKS 255 // Byte counters are drained before they can wrap
+
+#if STATS_BINS != 18
+#error "update the unroll count in board_stats()"
+#endif
+
+/* GCC vector extensions, 16 bytes (plain SSE2). A compare gives all ones in
+ * the lanes that match, so subtracting it adds 1 to those lane counters.
+ */
+typedef int CellVector __attribute__((vector_size(16)));
+typedef signed char ByteVector __attribute__((vector_size(16)));
+typedef unsigned char CountVector __attribute__((vector_size(16)));
+typedef unsigned long long WideVector __attribute__((vector_size(16)));
+
+/* Load 16 cells and keep the low byte of each. Which lane a cell lands in
+ * does not matter, only how many lanes hold each value.
+ */
+static inline ByteVector load_block(const int* cells) {
+    CellVector a, b, c, d;
+    memcpy(&a, cells, sizeof(a)); // Unaligned loads; rows need not start on a vector boundary
+    memcpy(&b, cells + 4, sizeof(b));
+    memcpy(&c, cells + 8, sizeof(c));
+    memcpy(&d, cells + 12, sizeof(d));
+    CellVector packed = (a & 0xFF) | ((b & 0xFF) << 8) | ((c & 0xFF) << 16) | (d << 24);
+    return (ByteVector)packed;
+}
+
+/* Add each byte counter vector to its total. Adjacent bytes are first
+ * summed into 16-bit fields, then a multiply gathers the four fields of each
+ * half into its top 16 bits.
+ */
+static void drain(CountVector* counts, long* totals) {
+    const WideVector low_bytes = (WideVector){0} + 0x00FF00FF00FF00FFULL;
+    for (int bin = 0; bin < STATS_BINS; bin++) {
+        WideVector wide = (WideVector)counts[bin];
+        WideVector pairs = (wide & low_bytes) + ((wide >> 8) & low_bytes);
+        WideVector sums = (pairs * 0x0001000100010001ULL) >> 48;
+        totals[bin] += (long)(sums[0] + sums[1]);
+        counts[bin] = (CountVector){0};
+    }
+}
+
+void board_stats(const int* board, size_t cells, BoardStats* out) {
+    CountVector counts[STATS_BINS];
+    long totals[STATS_BINS] = {0};
+    size_t i = 0;
+    int pending = 0;
+    const ByteVector lowest = (ByteVector){0} + STATS_MIN_VALUE;
+    
+    memset(counts, 0, sizeof(counts));
+    for (; i + STATS_BLOCK <= cells; i += STATS_BLOCK) {
+        ByteVector block = load_block(board + i);
+        ByteVector value = lowest;
+#pragma GCC unroll 18 // STATS_BINS; pragmas are not macro-expanded
+        for (int bin = 0; bin < STATS_BINS; bin++) {
+            counts[bin] -= (CountVector)(block == value);
+            value += 1;
+        }
+        if (++pending == STATS_FLUSH_BLOCKS) {
+            drain(counts, totals);
+            pending = 0;
+        }
+    }
+    drain(counts, totals);
+    
+    // Cells past the last full block
+    for (; i < cells; i++) {
+        if (board[i] >= STATS_MIN_VALUE && board[i] <= STATS_MAX_REWARD) {
+            totals[board[i] - STATS_MIN_VALUE]++;
+        }
+    }
+    
+    memset(out, 0, sizeof(*out));
+    for (int owner = 0; owner < STATS_MAX_OWNERS; owner++) {
+        out->owned[owner] = totals[-owner - STATS_MIN_VALUE];
+    }
+    for (int reward = 1; reward <= STATS_MAX_REWARD; reward++) {
+        int count = totals[reward - STATS_MIN_VALUE];
+        out->reward_hist[reward] = count;
+        out->free_cells += count;
+        out->free_reward += (long)reward * count;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#ifndef ANALYTICS_H
+#define ANALYTICS_H
+
+#include <stddef.h>
+
+#define STATS_MAX_OWNERS 9   // Captured cells hold -owner, owner 0..8
+#define STATS_MAX_REWARD 9   // Free cells hold a reward 1..9
+
+/* Whole-board totals, gathered in a single pass */
+typedef struct {
+    int owned[STATS_MAX_OWNERS];              // Captured cells per owner
+    int free_cells;                           // Cells with a reward left
+    long free_reward;                         // Sum of the rewards left
+    int reward_hist[STATS_MAX_REWARD + 1];    // Free cells per reward value; [0] is unused
+} BoardStats;
+
+/**
+ * @brief Count owners, free cells and rewards over a flat board.
+ *
+ * Cells are packed to bytes and counted 16 at a time with vector compares;
+ * only the last few cells take the scalar path. Values outside [-8, 9]
+ * (never written by the game) may be miscounted in the vector part.
+ * @param board Row-major cells.
+ * @param cells Number of cells (width * height).
+ * @param out Totals.
+ */
+void board_stats(const int* board, size_t cells, BoardStats* out);
+
+#endif // ANALYTICS_H
\ No newline at end of file
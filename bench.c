@@ -0,0 +1,622 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sched.h>
+#include "master_utils.h"
+#include "player_utils.h"
+#include "render.h"
+
+// Micro-benchmarks for the hot paths of master, player and view.
+// Each case is calibrated to run for at least BENCH_MIN_NS, repeated
+// BENCH_REPEATS times, and the median ns/op is reported.
+
+#define BENCH_MIN_NS 20000000ULL      // 20 ms per repetition
+#define BENCH_REPEATS 5
+#define BENCH_REGRESSION_PCT 15.0     // Slowdown flagged against the baseline
+#define BENCH_MAX_RESULTS 256
+#define ROUNDTRIP_ITERATIONS 20000
+#define SHARING_ITERATIONS 5000000
+#define BENCH_TERM_COLS 120           // Terminal used by the viewport cases
+#define BENCH_TERM_ROWS 40
+
+// Globals expected by master_utils.c (normally defined in master.c)
+GameState* game_state = NULL;
+GameSync* game_sync = NULL;
+GameMetrics* game_metrics = NULL;
+HintTable* game_hints = NULL;
+PlayerProcess players[MAX_PLAYERS];
+ViewProcess view;
+int player_count = 0;
+size_t game_state_size = 0;
+PaddedBoard padded_board;
+const KernelSet* kernels = NULL;
+Connectivity connectivity;
+MasterOptions master_options;
+Checkpointer checkpointer;
+CheckpointInfo resume_info;
+volatile sig_atomic_t stop_signal = 0;
+
+typedef struct {
+    char name[32];
+    int width, height, players;
+    double ns_per_op;
+} BenchResult;
+
+typedef void (*BenchFn)(long iterations);
+
+static const int board_sizes[][2] = {{10, 10}, {20, 20}, {64, 64}, {256, 256}};
+static const int player_counts[] = {1, 4, 9};
+
+static BenchResult results[BENCH_MAX_RESULTS];
+static int result_count = 0;
+static volatile long sink = 0;        // Defeats dead-code elimination
+static BoardWindow windows[MAX_PLAYERS];
+static HintTable hints;                // Private copy; the layout is what matters, not the segment
+static char* render_buffer = NULL;
+static size_t render_capacity = 0;
+
+static void setup_game(int width, int height, int count) {
+    free(game_state);
+    game_state_size = sizeof(GameState) + width * height * sizeof(int);
+    game_state = (GameState*)calloc(1, game_state_size);
+    if (game_state == NULL) {
+        perror("calloc");
+        exit(EXIT_FAILURE);
+    }
+    
+    game_state->width = width;
+    game_state->height = height;
+    game_state->player_count = count;
+    player_count = count;
+    generate_board(game_state, 42);
+    place_players_on_board();
+    init_padded_board();
+    init_connectivity();
+    
+    for (int i = 0; i < count; i++) {
+        snapshot_window(game_state, game_sync, i, LOOKAHEAD_DISTANCE, &windows[i]);
+        hints_publish(&hints, i, &padded_board, game_state->players[i].x, game_state->players[i].y);
+    }
+    
+    free(render_buffer);
+    render_capacity = render_buffer_size(width, height, count);
+    render_buffer = malloc(render_capacity);
+    if (render_buffer == NULL) {
+        perror("malloc");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void bench_process_movement(long iterations) {
+    int width = game_state->width;
+    for (long i = 0; i < iterations; i++) {
+        int p = i % player_count;
+        unsigned char dir = i & 7;
+        Player saved = game_state->players[p];
+        int nx = saved.x + movement[dir][0];
+        int ny = saved.y + movement[dir][1];
+        bool inside = nx >= 0 && nx < width && ny >= 0 && ny < game_state->height;
+        int cell = inside ? game_state->board[ny * width + nx] : 0;
+        
+        sink += process_movement(p, dir);
+        
+        // Undo so every iteration sees the same board
+        game_state->players[p] = saved;
+        if (inside) {
+            game_state->board[ny * width + nx] = cell;
+            *padded_cell(&padded_board, nx, ny) = cell;
+        }
+    }
+}
+
+/* Bounds-checked reference versions (the pre-sentinel code), kept to
+ * measure what the padded board saves.
+ */
+static bool can_player_move_checked(int player_idx) {
+    int width = game_state->width;
+    int height = game_state->height;
+    int x = game_state->players[player_idx].x;
+    int y = game_state->players[player_idx].y;
+    
+    for (int dir = 0; dir < 8; dir++) {
+        int new_x = x + movement[dir][0];
+        int new_y = y + movement[dir][1];
+        if (new_x >= 0 && new_x < width && new_y >= 0 && new_y < height &&
+            game_state->board[new_y * width + new_x] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool probe_move_checked(int player_idx, unsigned char direction) {
+    if (direction > 7) {
+        return false;
+    }
+    int width = game_state->width;
+    int new_x = game_state->players[player_idx].x + movement[direction][0];
+    int new_y = game_state->players[player_idx].y + movement[direction][1];
+    if (new_x < 0 || new_x >= width || new_y < 0 || new_y >= game_state->height) {
+        return false;
+    }
+    return game_state->board[new_y * width + new_x] > 0;
+}
+
+static bool probe_move_padded(int player_idx, unsigned char direction) {
+    if (direction > 7) {
+        return false;
+    }
+    const int* cell = padded_cell(&padded_board, game_state->players[player_idx].x,
+                                  game_state->players[player_idx].y);
+    return cell[padded_board.dir_offset[direction]] > 0;
+}
+
+static void bench_can_move_checked(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        sink += can_player_move_checked(i % player_count);
+    }
+}
+
+static void bench_probe_checked(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        sink += probe_move_checked(i % player_count, i & 7);
+    }
+}
+
+static void bench_probe_padded(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        sink += probe_move_padded(i % player_count, i & 7);
+    }
+}
+
+static void bench_can_player_move(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        sink += can_player_move(i % player_count);
+    }
+}
+
+/* The same loops forced onto the generic kernels, to measure what the
+ * size-specialized ones save (identical for sizes without specialization)
+ */
+static void bench_process_movement_generic(long iterations) {
+    const KernelSet* selected = kernels;
+    kernels = kernels_generic();
+    bench_process_movement(iterations);
+    kernels = selected;
+}
+
+static void bench_can_move_generic(long iterations) {
+    const KernelSet* selected = kernels;
+    kernels = kernels_generic();
+    bench_can_player_move(iterations);
+    kernels = selected;
+}
+
+static void bench_choose_unrolled(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        sink += choose_best_move_unrolled(&windows[i % player_count]);
+    }
+}
+
+/* Scalar reference for board_stats(), to measure what the vector pass saves */
+static void board_stats_scalar(const int* board, size_t cells, BoardStats* out) {
+    memset(out, 0, sizeof(*out));
+    for (size_t i = 0; i < cells; i++) {
+        int value = board[i];
+        if (value > 0) {
+            out->free_cells++;
+            out->free_reward += value;
+            out->reward_hist[value]++;
+        } else if (value > -STATS_MAX_OWNERS) {
+            out->owned[-value]++;
+        }
+    }
+}
+
+static void bench_board_stats(long iterations) {
+    BoardStats stats;
+    for (long i = 0; i < iterations; i++) {
+        board_stats(game_state->board, (size_t)game_state->width * game_state->height, &stats);
+        sink += stats.free_reward;
+    }
+}
+
+static void bench_board_stats_scalar(long iterations) {
+    BoardStats stats;
+    for (long i = 0; i < iterations; i++) {
+        board_stats_scalar(game_state->board, (size_t)game_state->width * game_state->height, &stats);
+        sink += stats.free_reward;
+    }
+}
+
+static void bench_choose_best_move(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        sink += choose_best_move(&windows[i % player_count]);
+    }
+}
+
+static void bench_hints_publish(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        int p = i % player_count;
+        hints_publish(&hints, p, &padded_board, game_state->players[p].x, game_state->players[p].y);
+    }
+    sink += hints.players[0].seq;
+}
+
+static void bench_hinted_move(long iterations) {
+    MoveHint hint;
+    unsigned char move = 0;
+    for (long i = 0; i < iterations; i++) {
+        if (hints_read(&hints, i % player_count, &hint) && choose_hinted_move(&hint, &move)) {
+            sink += move;
+        }
+    }
+}
+
+static void bench_snapshot_window(long iterations) {
+    BoardWindow window;
+    for (long i = 0; i < iterations; i++) {
+        sink += snapshot_window(game_state, game_sync, i % player_count, LOOKAHEAD_DISTANCE, &window);
+    }
+}
+
+static void bench_render(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        sink += render_game_state(game_state, render_buffer, render_capacity);
+    }
+}
+
+static void bench_render_viewport(long iterations) {
+    RenderView viewport = {0, 0, 0, 0, 1, 1, false, 0};
+    render_view_fit(&viewport, game_state, BENCH_TERM_COLS, BENCH_TERM_ROWS);
+    for (long i = 0; i < iterations; i++) {
+        sink += render_viewport(game_state, &viewport, render_buffer, render_capacity);
+    }
+}
+
+static void bench_render_overview(long iterations) {
+    RenderView overview = {0, 0, 0, 0, 1, 1, true, -1};
+    render_view_fit(&overview, game_state, BENCH_TERM_COLS, BENCH_TERM_ROWS);
+    for (long i = 0; i < iterations; i++) {
+        sink += render_viewport(game_state, &overview, render_buffer, render_capacity);
+    }
+}
+
+static void bench_place_players(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        place_players_on_board();
+        sink += game_state->players[0].x;
+    }
+}
+
+static void bench_generate_board(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        generate_board(game_state, (unsigned int)i);
+        sink += game_state->board[0];
+    }
+}
+
+static void bench_connectivity_relabel(long iterations) {
+    for (long i = 0; i < iterations; i++) {
+        connectivity_relabel(&connectivity);
+        sink += connectivity.comp_count;
+    }
+}
+
+static void bench_log_filtered(long iterations) {
+    log_threshold = LOG_INFO;
+    for (long i = 0; i < iterations; i++) {
+        LOG(LOG_TRACE, "move player=%d dir=%u valid=%d", (int)(i % 9), (unsigned int)(i & 7), 1);
+    }
+}
+
+static void bench_log_write(long iterations) {
+    log_threshold = LOG_TRACE;
+    for (long i = 0; i < iterations; i++) {
+        LOG(LOG_TRACE, "move player=%d dir=%u valid=%d", (int)(i % 9), (unsigned int)(i & 7), 1);
+    }
+    log_threshold = LOG_INFO;
+}
+
+static double run_once(BenchFn fn, long iterations) {
+    unsigned long long start = metrics_now_ns();
+    fn(iterations);
+    return (double)(metrics_now_ns() - start);
+}
+
+static int compare_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double measure(BenchFn fn) {
+    long iterations = 1;
+    
+    // Calibrate: grow the batch until one repetition is long enough to time
+    while (run_once(fn, iterations) < BENCH_MIN_NS / 10 && iterations < (1L << 30)) {
+        iterations *= 2;
+    }
+    iterations *= 10;
+    
+    double samples[BENCH_REPEATS];
+    for (int r = 0; r < BENCH_REPEATS; r++) {
+        samples[r] = run_once(fn, iterations) / iterations;
+    }
+    qsort(samples, BENCH_REPEATS, sizeof(double), compare_double);
+    return samples[BENCH_REPEATS / 2];
+}
+
+static void record(const char* name, int width, int height, int count, double ns) {
+    if (result_count >= BENCH_MAX_RESULTS) {
+        return;
+    }
+    BenchResult* r = &results[result_count++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->width = width;
+    r->height = height;
+    r->players = count;
+    r->ns_per_op = ns;
+    printf("%-20s %4dx%-4d p%d %12.1f ns/op\n", name, width, height, count, ns);
+    fflush(stdout);
+}
+
+static double bench_sync_roundtrip(void) {
+    // Two primitives in a shared anonymous mapping, ping-ponged with a child
+    SyncSem* sems = mmap(NULL, 2 * sizeof(SyncSem), PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (sems == MAP_FAILED) {
+        perror("mmap");
+        exit(EXIT_FAILURE);
+    }
+    sync_init(&sems[0], 0);
+    sync_init(&sems[1], 0);
+    
+    pid_t pid = fork();
+    if (pid == 0) {
+        for (int i = 0; i < ROUNDTRIP_ITERATIONS; i++) {
+            sync_wait(&sems[0]);
+            sync_post(&sems[1]);
+        }
+        _exit(EXIT_SUCCESS);
+    } else if (pid < 0) {
+        perror("fork");
+        exit(EXIT_FAILURE);
+    }
+    
+    unsigned long long start = metrics_now_ns();
+    for (int i = 0; i < ROUNDTRIP_ITERATIONS; i++) {
+        sync_post(&sems[0]);
+        sync_wait(&sems[1]);
+    }
+    double ns = (double)(metrics_now_ns() - start) / ROUNDTRIP_ITERATIONS;
+    
+    waitpid(pid, NULL, 0);
+    sync_destroy(&sems[0]);
+    sync_destroy(&sems[1]);
+    munmap(sems, 2 * sizeof(SyncSem));
+    return ns;
+}
+
+/* The player entry as it was before structs.h gave each one a cache line */
+typedef struct {
+    char name[16];
+    unsigned int score;
+    unsigned int invalid_moves;
+    unsigned int valid_moves;
+    unsigned short x, y;
+    pid_t pid;
+    bool is_blocked;
+} PackedPlayer;
+
+/* Run the calling process on the n-th CPU it may use, if there is one */
+static void pin_to_nth_cpu(int n) {
+    cpu_set_t allowed, one;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &allowed) && n-- == 0) {
+            CPU_ZERO(&one);
+            CPU_SET(cpu, &one);
+            sched_setaffinity(0, sizeof(one), &one);
+            return;
+        }
+    }
+}
+
+/* The parent keeps writing player 0's score, as the master does, while a
+ * child on another CPU writes player 1's valid_moves. With entries stride
+ * bytes apart the two share a line when stride is below a cache line.
+ */
+static double bench_player_sharing(size_t stride) {
+    size_t size = 2 * CACHE_LINE_SIZE + 2 * stride;
+    unsigned char* table = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (table == MAP_FAILED) {
+        perror("mmap");
+        exit(EXIT_FAILURE);
+    }
+    cpu_set_t saved;
+    sched_getaffinity(0, sizeof(saved), &saved);
+    volatile unsigned int* started = (volatile unsigned int*)table;
+    volatile unsigned int* mine = (volatile unsigned int*)(table + CACHE_LINE_SIZE +
+                                                          offsetof(Player, score));
+    volatile unsigned int* theirs = (volatile unsigned int*)(table + CACHE_LINE_SIZE + stride +
+                                                            offsetof(Player, valid_moves));
+    
+    pid_t pid = fork();
+    if (pid == 0) {
+        pin_to_nth_cpu(1);
+        *started = 1;
+        for (long i = 0; i < SHARING_ITERATIONS; i++) {
+            *theirs = *theirs + 1;
+        }
+        _exit(EXIT_SUCCESS);
+    } else if (pid < 0) {
+        perror("fork");
+        exit(EXIT_FAILURE);
+    }
+    
+    pin_to_nth_cpu(0);
+    while (*started == 0) {
+        sched_yield();
+    }
+    unsigned long long start = metrics_now_ns();
+    for (long i = 0; i < SHARING_ITERATIONS; i++) {
+        *mine = *mine + 1;
+    }
+    double ns = (double)(metrics_now_ns() - start) / SHARING_ITERATIONS;
+    
+    waitpid(pid, NULL, 0);
+    munmap(table, size);
+    sched_setaffinity(0, sizeof(saved), &saved);
+    return ns;
+}
+
+static void write_results(const char* path) {
+    FILE* f = fopen(path, "w");
+    if (f == NULL) {
+        perror(path);
+        return;
+    }
+    fprintf(f, "# name width height players ns_per_op\n");
+    for (int i = 0; i < result_count; i++) {
+        fprintf(f, "%s %d %d %d %.1f\n", results[i].name, results[i].width,
+                results[i].height, results[i].players, results[i].ns_per_op);
+    }
+    fclose(f);
+}
+
+static int compare_baseline(const char* path) {
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        return -1;
+    }
+    
+    int regressions = 0;
+    char line[256], name[32];
+    int width, height, count;
+    double base;
+    
+    printf("\nComparison against %s (regression threshold %.0f%%):\n", path, BENCH_REGRESSION_PCT);
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (line[0] == '#' || sscanf(line, "%31s %d %d %d %lf", name, &width, &height, &count, &base) != 5) {
+            continue;
+        }
+        for (int i = 0; i < result_count; i++) {
+            BenchResult* r = &results[i];
+            if (strcmp(r->name, name) == 0 && r->width == width && r->height == height &&
+                r->players == count && base > 0) {
+                double delta = 100.0 * (r->ns_per_op - base) / base;
+                bool regressed = delta > BENCH_REGRESSION_PCT;
+                regressions += regressed;
+                printf("%-20s %4dx%-4d p%d %10.1f -> %10.1f ns/op (%+6.1f%%)%s\n", name, width,
+                       height, count, base, r->ns_per_op, delta, regressed ? "  REGRESSION" : "");
+            }
+        }
+    }
+    fclose(f);
+    return regressions;
+}
+
+int main(int argc, char* argv[]) {
+    const char* output_path = "bench_results.txt";
+    const char* baseline_path = NULL;
+    int opt;
+    
+    while ((opt = getopt(argc, argv, "o:b:")) != -1) {
+        switch (opt) {
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'b':
+                baseline_path = optarg;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-o results_file] [-b baseline_file]\n", argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+    
+    // Producer cost only: records go to /dev/null, unthrottled; a full ring drops
+    setenv(LOG_ENV_FILE, "/dev/null", 1);
+    setenv(LOG_ENV_RATE, "0", 1);
+    log_init("bench");
+    
+    game_sync = mmap(NULL, sizeof(GameSync), PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (game_sync == MAP_FAILED) {
+        perror("mmap");
+        exit(EXIT_FAILURE);
+    }
+    sync_init(&game_sync->game_state_mutex, 1);
+    sync_init(&game_sync->reader_count_mutex, 1);
+    
+    for (size_t s = 0; s < sizeof(board_sizes) / sizeof(board_sizes[0]); s++) {
+        int width = board_sizes[s][0];
+        int height = board_sizes[s][1];
+        
+        for (size_t p = 0; p < sizeof(player_counts) / sizeof(player_counts[0]); p++) {
+            int count = player_counts[p];
+            setup_game(width, height, count);
+            
+            record("process_movement", width, height, count, measure(bench_process_movement));
+            record("can_player_move", width, height, count, measure(bench_can_player_move));
+            record("process_movement_generic", width, height, count, measure(bench_process_movement_generic));
+            record("can_move_generic", width, height, count, measure(bench_can_move_generic));
+            record("can_move_checked", width, height, count, measure(bench_can_move_checked));
+            record("probe_padded", width, height, count, measure(bench_probe_padded));
+            record("probe_checked", width, height, count, measure(bench_probe_checked));
+            record("choose_best_move", width, height, count, measure(bench_choose_best_move));
+            record("choose_unrolled", width, height, count, measure(bench_choose_unrolled));
+            record("snapshot_window", width, height, count, measure(bench_snapshot_window));
+            record("hints_publish", width, height, count, measure(bench_hints_publish));
+            record("hinted_move", width, height, count, measure(bench_hinted_move));
+            record("place_players", width, height, count, measure(bench_place_players));
+        }
+        
+        // Whole-board work depends on the size, not on the player count
+        setup_game(width, height, MAX_PLAYERS);
+        record("render_game_state", width, height, MAX_PLAYERS, measure(bench_render));
+        record("render_viewport", width, height, MAX_PLAYERS, measure(bench_render_viewport));
+        record("render_overview", width, height, MAX_PLAYERS, measure(bench_render_overview));
+        record("generate_board", width, height, MAX_PLAYERS, measure(bench_generate_board));
+        record("connectivity_relabel", width, height, MAX_PLAYERS, measure(bench_connectivity_relabel));
+        record("board_stats", width, height, MAX_PLAYERS, measure(bench_board_stats));
+        record("board_stats_scalar", width, height, MAX_PLAYERS, measure(bench_board_stats_scalar));
+    }
+    
+    record("sync_roundtrip", 0, 0, 1, bench_sync_roundtrip());
+    record("player_sharing_packed", 0, 0, 2, bench_player_sharing(sizeof(PackedPlayer)));
+    record("player_sharing_padded", 0, 0, 2, bench_player_sharing(sizeof(Player)));
+    record("log_filtered", 0, 0, 1, measure(bench_log_filtered));
+    record("log_write", 0, 0, 1, measure(bench_log_write));
+    
+    write_results(output_path);
+    printf("\nResults written to %s\n", output_path);
+    
+    int regressions = 0;
+    if (baseline_path != NULL) {
+        regressions = compare_baseline(baseline_path);
+        if (regressions < 0) {
+            write_results(baseline_path);
+            printf("No baseline found; saved this run as %s\n", baseline_path);
+            regressions = 0;
+        } else {
+            printf("%d regression(s)\n", regressions);
+        }
+    }
+    
+    free(game_state);
+    free(render_buffer);
+    log_shutdown();
+    connectivity_free(&connectivity);
+    padded_board_free(&padded_board);
+    munmap(game_sync, sizeof(GameSync));
+    return regressions > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,42 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "board.h"
+
+int padded_board_init(PaddedBoard* board, int width, int height, int border,
+                      const int directions[8][2]) {
+    board->width = width;
+    board->height = height;
+    board->border = border;
+    board->stride = width + 2 * border;
+    
+    size_t count = (size_t)board->stride * (height + 2 * border);
+    board->cells = malloc(count * sizeof(int));
+    if (board->cells == NULL) {
+        board->origin = NULL;
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        board->cells[i] = BOARD_SENTINEL;
+    }
+    board->origin = board->cells + border * board->stride + border;
+    
+    for (int dir = 0; dir < 8; dir++) {
+        board->dir_offset[dir] = directions[dir][1] * board->stride + directions[dir][0];
+    }
+    return 0;
+}
+
+void padded_board_load(PaddedBoard* board, const int* flat) {
+    for (int y = 0; y < board->height; y++) {
+        memcpy(padded_cell(board, 0, y), flat + y * board->width, board->width * sizeof(int));
+    }
+}
+
+void padded_board_free(PaddedBoard* board) {
+    free(board->cells);
+    board->cells = NULL;
+    board->origin = NULL;
+}
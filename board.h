@@ -0,0 +1,52 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <limits.h>
+
+/* Value of the permanently captured cells around a padded board */
+#define BOARD_SENTINEL INT_MIN
+
+/* Board surrounded by a border of sentinel cells. Since a sentinel is never
+ * free (<= 0), a neighbour probe is a single load at a precomputed linear
+ * offset, with no bounds checks.
+ */
+typedef struct {
+    int width, height;     // Playable size
+    int border;            // Sentinel cells on each side
+    int stride;            // Row length including the border
+    int* cells;            // Whole allocation, border included
+    int* origin;           // Cell (0, 0) of the playable area
+    int dir_offset[8];     // Linear offset of each movement direction
+} PaddedBoard;
+
+/**
+ * @brief Allocate a padded board with every cell set to the sentinel.
+ * @param board Board to initialize.
+ * @param width Playable width.
+ * @param height Playable height.
+ * @param border Sentinel cells on each side (1 for single steps, more for look-ahead).
+ * @param directions The 8 movement vectors as {dx, dy}.
+ * @return 0 on success, -1 if allocation failed.
+ */
+int padded_board_init(PaddedBoard* board, int width, int height, int border,
+                      const int directions[8][2]);
+
+/**
+ * @brief Copy a flat width*height board into the playable area.
+ * @param board An initialized padded board.
+ * @param flat Row-major source cells.
+ */
+void padded_board_load(PaddedBoard* board, const int* flat);
+
+/**
+ * @brief Free a padded board.
+ * @param board Board to free.
+ */
+void padded_board_free(PaddedBoard* board);
+
+/* Pointer to playable cell (x, y) */
+static inline int* padded_cell(const PaddedBoard* board, int x, int y) {
+    return board->origin + y * board->stride + x;
+}
+
+#endif // BOARD_H
@@ -0,0 +1,173 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "checkpoint.h"
+#include "metrics.h"
+
+int checkpoint_init(Checkpointer* cp, size_t state_size) {
+    memset(cp, 0, sizeof(*cp));
+    cp->copy = malloc(state_size);
+    if (cp->copy == NULL) {
+        return -1;
+    }
+    cp->size = state_size;
+    return 0;
+}
+
+void checkpoint_capture(Checkpointer* cp, const GameState* state, const CheckpointInfo* info) {
+    unsigned long long start = metrics_now_ns();
+    memcpy(cp->copy, state, cp->size);
+    cp->info = *info;
+    cp->pause_ns = metrics_now_ns() - start;
+}
+
+static int write_all(int fd, const void* data, size_t size) {
+    const char* p = data;
+    while (size > 0) {
+        ssize_t n = write(fd, p, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        p += n;
+        size -= n;
+    }
+    return 0;
+}
+
+static int write_checkpoint(const Checkpointer* cp, const char* path) {
+    char tmp_path[PATH_MAX];
+    CheckpointHeader header;
+    
+    memset(&header, 0, sizeof(header));
+    header.magic = CHECKPOINT_MAGIC;
+    header.version = CHECKPOINT_VERSION;
+    header.state_size = cp->size;
+    header.width = cp->copy->width;
+    header.height = cp->copy->height;
+    header.player_count = cp->copy->player_count;
+    header.info = cp->info;
+    
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    int fd = open(tmp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(tmp_path);
+        return -1;
+    }
+    if (write_all(fd, &header, sizeof(header)) != 0 || write_all(fd, cp->copy, cp->size) != 0 ||
+        fsync(fd) != 0) {
+        perror(tmp_path);
+        close(fd);
+        unlink(tmp_path);
+        return -1;
+    }
+    close(fd);
+    
+    // A crash mid-write leaves the previous checkpoint intact
+    if (rename(tmp_path, path) != 0) {
+        perror(path);
+        return -1;
+    }
+    return 0;
+}
+
+/* Collect the previous writer without blocking; returns true once it is gone */
+static bool reap_writer(Checkpointer* cp, int flags) {
+    int status;
+    
+    if (cp->writer <= 0) {
+        return true;
+    }
+    pid_t pid = waitpid(cp->writer, &status, flags);
+    if (pid == 0) {
+        return false;
+    }
+    if (pid == cp->writer && !(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+        cp->failed++;
+    }
+    cp->writer = 0;
+    return true;
+}
+
+int checkpoint_flush(Checkpointer* cp, const char* path) {
+    if (!reap_writer(cp, WNOHANG)) {
+        cp->skipped++;
+        return -1;
+    }
+    
+    unsigned long long start = metrics_now_ns();
+    pid_t pid = fork();
+    if (pid == 0) {
+        // The writer must not run the master's handlers, which unlink shared memory
+        signal(SIGINT, SIG_DFL);
+        signal(SIGTERM, SIG_DFL);
+        _exit(write_checkpoint(cp, path) == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+    } else if (pid < 0) {
+        perror("fork");
+        return -1;
+    }
+    
+    cp->pause_ns += metrics_now_ns() - start;
+    if (cp->pause_ns > cp->max_pause_ns) {
+        cp->max_pause_ns = cp->pause_ns;
+    }
+    cp->writer = pid;
+    cp->written++;
+    return 0;
+}
+
+void checkpoint_finish(Checkpointer* cp) {
+    reap_writer(cp, 0);
+    free(cp->copy);
+    cp->copy = NULL;
+}
+
+int checkpoint_read_header(const char* path, CheckpointHeader* header) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t n = read(fd, header, sizeof(*header));
+    close(fd);
+    
+    if (n != (ssize_t)sizeof(*header) || header->magic != CHECKPOINT_MAGIC ||
+        header->version != CHECKPOINT_VERSION ||
+        header->state_size != sizeof(GameState) + (size_t)header->width * header->height * sizeof(int)) {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+int checkpoint_read_state(const char* path, GameState* state, size_t size) {
+    CheckpointHeader header;
+    
+    if (checkpoint_read_header(path, &header) != 0) {
+        return -1;
+    }
+    if (header.state_size != size) {
+        errno = EINVAL;
+        return -1;
+    }
+    
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    ssize_t n = pread(fd, state, size, sizeof(header));
+    close(fd);
+    if (n != (ssize_t)size) {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <sys/types.h>
+#include "structs.h"
+
+#define CHECKPOINT_MAGIC 0x4b434843u   // "CHCK"
+#define CHECKPOINT_VERSION 2            // 2: cache-line aligned GameState layout
+
+/* Master bookkeeping that is not part of the shared game state */
+typedef struct {
+    int start_index;                // Next player in the round-robin
+    long idle_ms;                   // Time since the last valid move
+    unsigned long long elapsed_ns;  // Game time played so far
+} CheckpointInfo;
+
+/* File header, followed by state_size bytes of GameState */
+typedef struct {
+    unsigned int magic;
+    unsigned int version;
+    unsigned long long state_size;
+    unsigned short width, height;
+    unsigned int player_count;
+    CheckpointInfo info;
+} CheckpointHeader;
+
+/* Checkpoints are taken in two steps: the state is copied to private memory
+ * while the caller holds the state lock, then a forked child writes that
+ * copy out. The child's view of the copy is copy-on-write, so the game only
+ * pauses for the memcpy and the fork, never for the disk.
+ */
+typedef struct {
+    GameState* copy;                // Private copy of the state
+    size_t size;                    // Size of the copy
+    CheckpointInfo info;            // Bookkeeping captured with the copy
+    pid_t writer;                   // Writer still running, or 0
+    unsigned long written;          // Writers started
+    unsigned long skipped;          // Checkpoints dropped because a writer was busy
+    unsigned long failed;           // Writers that exited with an error
+    unsigned long long pause_ns;    // Pause caused by the current checkpoint so far
+    unsigned long long max_pause_ns; // Longest capture plus fork
+} Checkpointer;
+
+/**
+ * @brief Allocate the private copy.
+ * @param cp Checkpointer to initialize.
+ * @param state_size Size of the game state in bytes.
+ * @return 0 on success, -1 if allocation failed.
+ */
+int checkpoint_init(Checkpointer* cp, size_t state_size);
+
+/**
+ * @brief Copy the state and bookkeeping. The caller must hold the state lock.
+ * @param cp An initialized checkpointer.
+ * @param state Game state to copy.
+ * @param info Master bookkeeping at this point of the game.
+ */
+void checkpoint_capture(Checkpointer* cp, const GameState* state, const CheckpointInfo* info);
+
+/**
+ * @brief Fork a child that writes the last capture to path atomically.
+ *
+ * Skipped if the previous writer has not finished yet.
+ * @param cp An initialized checkpointer with a capture.
+ * @param path Checkpoint file; written to path.tmp and renamed.
+ * @return 0 if a writer was started, -1 if skipped or fork failed.
+ */
+int checkpoint_flush(Checkpointer* cp, const char* path);
+
+/**
+ * @brief Wait for the last writer and free the checkpointer.
+ * @param cp Checkpointer to finish.
+ */
+void checkpoint_finish(Checkpointer* cp);
+
+/**
+ * @brief Read and validate a checkpoint file header.
+ * @param path Checkpoint file.
+ * @param header Output header.
+ * @return 0 on success, -1 with errno set on failure (EINVAL if not a checkpoint).
+ */
+int checkpoint_read_header(const char* path, CheckpointHeader* header);
+
+/**
+ * @brief Read the game state stored in a checkpoint.
+ * @param path Checkpoint file.
+ * @param state Destination, e.g. the shared memory segment.
+ * @param size Size of the destination; must match the stored state.
+ * @return 0 on success, -1 with errno set on failure.
+ */
+int checkpoint_read_state(const char* path, GameState* state, size_t size);
+
+#endif // CHECKPOINT_H
\ No newline at end of file
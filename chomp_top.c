@@ -0,0 +1,111 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include "metrics.h"
+
+#define DEFAULT_INTERVAL_MS 1000
+#define ATTACH_RETRY_US 200000
+
+// chomp-top: live monitor of the /game_metrics segment. It only reads
+// relaxed counters, so it never takes any game lock or slows the master.
+
+static volatile sig_atomic_t running = 1;
+
+void display_metrics(const GameMetrics* metrics, unsigned long long* last_moves,
+                     unsigned long long* last_ns);
+void sig_handler(int signo);
+
+int main(int argc, char* argv[]) {
+    int interval_ms = DEFAULT_INTERVAL_MS;
+    
+    if (argc > 2) {
+        fprintf(stderr, "Usage: %s [interval_ms]\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    if (argc == 2) {
+        interval_ms = atoi(argv[1]);
+        if (interval_ms <= 0) {
+            interval_ms = DEFAULT_INTERVAL_MS;
+        }
+    }
+    
+    signal(SIGINT, sig_handler);
+    signal(SIGTERM, sig_handler);
+    
+    const GameMetrics* metrics = NULL;
+    while (running && (metrics = metrics_attach()) == NULL) {
+        fprintf(stderr, "\rWaiting for a game to publish %s...", NAME_METRICS);
+        usleep(ATTACH_RETRY_US);
+    }
+    if (metrics == NULL) {
+        return 0;
+    }
+    
+    unsigned long long last_moves = metrics_load(&metrics->global.moves);
+    unsigned long long last_ns = metrics_now_ns();
+    
+    while (running) {
+        usleep(interval_ms * 1000);
+        display_metrics(metrics, &last_moves, &last_ns);
+        if (__atomic_load_n(&metrics->game_over, __ATOMIC_RELAXED)) {
+            break;
+        }
+    }
+    
+    munmap((void*)metrics, sizeof(GameMetrics));
+    return 0;
+}
+
+void display_metrics(const GameMetrics* metrics, unsigned long long* last_moves,
+                     unsigned long long* last_ns) {
+    unsigned long long now = metrics_now_ns();
+    unsigned long long moves = metrics_load(&metrics->global.moves);
+    unsigned long long invalid = metrics_load(&metrics->global.invalid_moves);
+    unsigned long long lock_ns = metrics_load(&metrics->global.lock_wait_ns);
+    unsigned long long locks = metrics_load(&metrics->global.lock_acquisitions);
+    unsigned long long view_ns = metrics_load(&metrics->global.view_wait_ns);
+    unsigned long long frames = metrics_load(&metrics->global.view_frames);
+    
+    double elapsed = (now - *last_ns) / 1e9;
+    double rate = elapsed > 0 ? (moves - *last_moves) / elapsed : 0.0;
+    *last_moves = moves;
+    *last_ns = now;
+    
+    printf("\033[2J\033[H");
+    printf("===== chomp-top =====  uptime %.1fs  %s\n",
+           (now - metrics->start_ns) / 1e9,
+           __atomic_load_n(&metrics->game_over, __ATOMIC_RELAXED) ? "GAME OVER" : "RUNNING");
+    printf("moves: %llu (%.1f/s)  invalid: %llu\n", moves, rate, invalid);
+    printf("lock wait: avg %.1f us over %llu acquisitions\n",
+           locks > 0 ? lock_ns / 1e3 / locks : 0.0, locks);
+    printf("view wait: avg %.1f us over %llu frames\n\n",
+           frames > 0 ? view_ns / 1e3 / frames : 0.0, frames);
+    
+    printf("%-3s %10s %10s %6s %6s  latency histogram (us, <2^b)\n",
+           "id", "moves", "invalid", "queue", "max_q");
+    for (unsigned int i = 0; i < metrics->player_count && i < METRICS_MAX_PLAYERS; i++) {
+        const PlayerMetrics* player = &metrics->players[i];
+        printf("%-3u %10llu %10llu %6llu %6llu ", i,
+               metrics_load(&player->moves), metrics_load(&player->invalid_moves),
+               metrics_load(&player->queue_depth), metrics_load(&player->max_queue_depth));
+        for (int b = 0; b < METRICS_LATENCY_BUCKETS; b++) {
+            unsigned long long count = metrics_load(&player->latency[b]);
+            if (count > 0) {
+                printf(" %d:%llu", b, count);
+            }
+        }
+        printf("\n");
+    }
+    fflush(stdout);
+}
+
+void sig_handler(int signo) {
+    (void)signo;
+    running = 0;
+}
@@ -0,0 +1,211 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "connectivity.h"
+
+int connectivity_init(Connectivity* conn, const PaddedBoard* board) {
+    size_t total = (size_t)board->stride * (board->height + 2 * board->border);
+    size_t playable = (size_t)board->width * board->height;
+    
+    memset(conn, 0, sizeof(*conn));
+    conn->board = board;
+    conn->labels = calloc(total, sizeof(int));
+    conn->stack = malloc(playable * sizeof(int));
+    // At most one component per two cells, plus label 0
+    conn->comp_capacity = (int)(playable / 2 + 2);
+    conn->comp_cells = malloc((size_t)conn->comp_capacity * sizeof(int));
+    conn->comp_reward = malloc((size_t)conn->comp_capacity * sizeof(long));
+    if (conn->labels == NULL || conn->stack == NULL || conn->comp_cells == NULL ||
+        conn->comp_reward == NULL) {
+        connectivity_free(conn);
+        return -1;
+    }
+    
+    connectivity_relabel(conn);
+    return 0;
+}
+
+/* Flood fill from start over free cells labelled old, giving them a new
+ * label and its totals; sentinels (<= 0) stop it at the border. Returns the
+ * new label.
+ */
+static int fill_component(Connectivity* conn, int start, int old) {
+    const PaddedBoard* board = conn->board;
+    const int* cells = board->cells;
+    int label = ++conn->comp_count;
+    int top = 0;
+    
+    conn->comp_cells[label] = 0;
+    conn->comp_reward[label] = 0;
+    conn->labels[start] = label;
+    conn->stack[top++] = start;
+    
+    while (top > 0) {
+        int cell = conn->stack[--top];
+        conn->comp_cells[label]++;
+        conn->comp_reward[label] += cells[cell];
+        
+        for (int dir = 0; dir < 8; dir++) {
+            int next = cell + board->dir_offset[dir];
+            if (cells[next] > 0 && conn->labels[next] == old) {
+                conn->labels[next] = label;
+                conn->stack[top++] = next;
+            }
+        }
+    }
+    return label;
+}
+
+void connectivity_relabel(Connectivity* conn) {
+    const PaddedBoard* board = conn->board;
+    const int* cells = board->cells;
+    size_t total = (size_t)board->stride * (board->height + 2 * board->border);
+    
+    memset(conn->labels, 0, total * sizeof(int));
+    conn->comp_count = 0;
+    conn->relabels++;
+    
+    for (int y = 0; y < board->height; y++) {
+        for (int x = 0; x < board->width; x++) {
+            int start = (int)(padded_cell(board, x, y) - cells);
+            if (cells[start] > 0 && conn->labels[start] == 0) {
+                fill_component(conn, start, 0);
+            }
+        }
+    }
+}
+
+/* Free runs around a cell, walking its 8 neighbours in direction order
+ * (N, NE, E, ... NW). Two orthogonal neighbours touch each other directly,
+ * so a captured diagonal between two free orthogonals does not break a run.
+ * One run means removing the cell cannot split its component. The direction
+ * that starts each run is stored in run_dirs.
+ */
+static int free_runs(const Connectivity* conn, const int* cell, int run_dirs[4]) {
+    bool free_ring[8];
+    int runs = 0;
+    
+    for (int dir = 0; dir < 8; dir++) {
+        free_ring[dir] = cell[conn->board->dir_offset[dir]] > 0;
+    }
+    for (int dir = 1; dir < 8; dir += 2) {
+        if (!free_ring[dir] && free_ring[dir - 1] && free_ring[(dir + 1) % 8]) {
+            free_ring[dir] = true;
+        }
+    }
+    for (int dir = 0; dir < 8; dir++) {
+        if (free_ring[dir] && !free_ring[(dir + 7) % 8]) {
+            run_dirs[runs++] = dir;
+        }
+    }
+    if (runs == 0 && free_ring[0]) {
+        run_dirs[runs++] = 0; // The whole ring is free
+    }
+    return runs;
+}
+
+void connectivity_capture(Connectivity* conn, int x, int y, int reward) {
+    const int* cell = padded_cell(conn->board, x, y);
+    int index = (int)(cell - conn->board->cells);
+    int label = conn->labels[index];
+    
+    if (label == 0) {
+        return; // Was not free: nothing changes
+    }
+    
+    conn->labels[index] = 0;
+    conn->comp_cells[label]--;
+    conn->comp_reward[label] -= reward;
+    
+    int run_dirs[4];
+    int runs = free_runs(conn, cell, run_dirs);
+    if (runs <= 1) {
+        return;
+    }
+    
+    // Out of fresh labels: a full pass compacts them again
+    if (conn->comp_count + runs >= conn->comp_capacity) {
+        connectivity_relabel(conn);
+        return;
+    }
+    
+    /* Refill from every run but the first: cells a fill does not reach keep
+     * the old label, so only this component is walked, never the whole board.
+     * A run already reached by an earlier fill is skipped.
+     */
+    conn->split_fills++;
+    for (int run = 1; run < runs; run++) {
+        int start = index + conn->board->dir_offset[run_dirs[run]];
+        if (conn->labels[start] != label) {
+            continue;
+        }
+        int piece = fill_component(conn, start, label);
+        conn->comp_cells[label] -= conn->comp_cells[piece];
+        conn->comp_reward[label] -= conn->comp_reward[piece];
+    }
+}
+
+/* Distinct component labels around (x, y); returns how many */
+static int neighbour_labels(const Connectivity* conn, int x, int y, int labels[8]) {
+    const int* cell = padded_cell(conn->board, x, y);
+    int index = (int)(cell - conn->board->cells);
+    int count = 0;
+    
+    for (int dir = 0; dir < 8; dir++) {
+        int label = conn->labels[index + conn->board->dir_offset[dir]];
+        bool seen = label == 0;
+        for (int i = 0; i < count && !seen; i++) {
+            seen = labels[i] == label;
+        }
+        if (!seen) {
+            labels[count++] = label;
+        }
+    }
+    return count;
+}
+
+void connectivity_reach(const Connectivity* conn, int x, int y, int* cells, long* reward) {
+    int labels[8];
+    int count = neighbour_labels(conn, x, y, labels);
+    
+    *cells = 0;
+    *reward = 0;
+    for (int i = 0; i < count; i++) {
+        *cells += conn->comp_cells[labels[i]];
+        *reward += conn->comp_reward[labels[i]];
+    }
+}
+
+bool connectivity_isolated(const Connectivity* conn, const GameState* state) {
+    int owner_labels[9][8];
+    int owner_counts[9];
+    
+    for (unsigned int p = 0; p < state->player_count; p++) {
+        owner_counts[p] = state->players[p].is_blocked ? 0 :
+            neighbour_labels(conn, state->players[p].x, state->players[p].y, owner_labels[p]);
+        
+        for (unsigned int q = 0; q < p; q++) {
+            for (int i = 0; i < owner_counts[p]; i++) {
+                for (int j = 0; j < owner_counts[q]; j++) {
+                    if (owner_labels[p][i] == owner_labels[q][j]) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void connectivity_free(Connectivity* conn) {
+    free(conn->labels);
+    free(conn->stack);
+    free(conn->comp_cells);
+    free(conn->comp_reward);
+    conn->labels = NULL;
+    conn->stack = NULL;
+    conn->comp_cells = NULL;
+    conn->comp_reward = NULL;
+}
\ No newline at end of file
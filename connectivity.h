@@ -0,0 +1,76 @@
+#ifndef CONNECTIVITY_H
+#define CONNECTIVITY_H
+
+#include <stdbool.h>
+#include "board.h"
+#include "structs.h"
+
+/* Connected components of free cells (8-connected, like player moves).
+ * Captures only ever remove free cells, so components only shrink or split:
+ * each capture updates its component's totals in O(1). When the captured
+ * cell's neighbour ring shows that a split is possible, only that component
+ * is relabelled, by flood-filling from the free runs around the cell.
+ */
+typedef struct {
+    const PaddedBoard* board;  // Board being tracked (the master's mirror)
+    int* labels;               // Component of each cell, same layout as board->cells; 0 if not free
+    int* stack;                // Flood-fill work stack
+    int* comp_cells;           // Free cells per component, indexed by label
+    long* comp_reward;         // Reward left per component, indexed by label
+    int comp_count;            // Labels in use are 1..comp_count
+    int comp_capacity;         // Size of comp_cells / comp_reward
+    unsigned long relabels;    // Full relabelling passes performed
+    unsigned long split_fills; // Component refills after a possible split
+} Connectivity;
+
+/**
+ * @brief Allocate the tracker and label the board.
+ * @param conn Tracker to initialize.
+ * @param board Padded board to track; it must outlive the tracker.
+ * @return 0 on success, -1 if allocation failed.
+ */
+int connectivity_init(Connectivity* conn, const PaddedBoard* board);
+
+/**
+ * @brief Label every component from scratch.
+ * @param conn An initialized tracker.
+ */
+void connectivity_relabel(Connectivity* conn);
+
+/**
+ * @brief Account for a free cell that has just been captured.
+ * @param conn An initialized tracker.
+ * @param x Column of the captured cell.
+ * @param y Row of the captured cell.
+ * @param reward Reward the cell held before the capture.
+ */
+void connectivity_capture(Connectivity* conn, int x, int y, int reward);
+
+/**
+ * @brief Free cells and reward a player standing at (x, y) can still reach.
+ * @param conn An initialized tracker.
+ * @param x Player column.
+ * @param y Player row.
+ * @param cells Output: reachable free cells.
+ * @param reward Output: total reward of those cells.
+ */
+void connectivity_reach(const Connectivity* conn, int x, int y, int* cells, long* reward);
+
+/**
+ * @brief Check whether no two active players can reach a common cell.
+ *
+ * Once true it stays true, since components never merge: no player can
+ * affect another player's outcome any more.
+ * @param conn An initialized tracker.
+ * @param state Game state with player positions and blocked flags.
+ * @return true if every component is reachable by at most one active player.
+ */
+bool connectivity_isolated(const Connectivity* conn, const GameState* state);
+
+/**
+ * @brief Free the tracker.
+ * @param conn Tracker to free.
+ */
+void connectivity_free(Connectivity* conn);
+
+#endif // CONNECTIVITY_H
\ No newline at end of file
@@ -0,0 +1,50 @@
+#!/bin/sh
+# Contention harness: runs 1..9 player_flood processes against master for each
+# load pattern and records throughput, latency and lock contention as CSV.
+#
+# Usage: ./flood_bench.sh [output.csv]
+# Environment: WIDTH, HEIGHT (board, default 64x64), TIMEOUT (seconds, default 1),
+#              PATTERNS (default "valid invalid oob pause mixed"), FLOOD_BURST, FLOOD_PAUSE_MS,
+#              INTAKE (master -i backend: auto, epoll or io_uring; default auto)
+
+OUTPUT=${1:-flood_results.csv}
+WIDTH=${WIDTH:-64}
+HEIGHT=${HEIGHT:-64}
+TIMEOUT=${TIMEOUT:-1}
+PATTERNS=${PATTERNS:-"valid invalid oob pause mixed"}
+INTAKE=${INTAKE:-auto}
+
+if [ ! -x ./master ] || [ ! -x ./player_flood ]; then
+    echo "Build first: make master player_flood" >&2
+    exit 1
+fi
+
+echo "pattern,players,moves,invalid,elapsed_s,moves_per_s,lock_wait_avg_us,latency_p50_us,latency_p99_us" > "$OUTPUT"
+
+for pattern in $PATTERNS; do
+    n=1
+    while [ "$n" -le 9 ]; do
+        flooders=""
+        i=0
+        while [ "$i" -lt "$n" ]; do
+            flooders="$flooders ./player_flood"
+            i=$((i + 1))
+        done
+
+        # shellcheck disable=SC2086
+        line=$(FLOOD_PATTERN=$pattern ./master -w "$WIDTH" -h "$HEIGHT" -d 0 -t "$TIMEOUT" -s 1 \
+               -i "$INTAKE" -p $flooders 2>/dev/null | grep '^metrics:')
+
+        field() {
+            echo "$line" | tr ' ' '\n' | sed -n "s/^$1=//p"
+        }
+
+        row="$pattern,$n,$(field moves),$(field invalid),$(field elapsed_s),$(field moves_per_s)"
+        row="$row,$(field lock_wait_avg_us),$(field latency_p50_us),$(field latency_p99_us)"
+        echo "$row" >> "$OUTPUT"
+        echo "$row"
+        n=$((n + 1))
+    done
+done
+
+echo "Results written to $OUTPUT"
@@ -0,0 +1,226 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include "frames.h"
+
+#define MAX_LEB128_BYTES 5
+
+typedef struct {
+    char magic[4];
+    uint16_t version;
+    uint16_t width;
+    uint16_t height;
+    uint16_t reserved;
+} StreamHeader;
+
+static size_t put_leb128(unsigned char* out, uint32_t value) {
+    size_t n = 0;
+    do {
+        unsigned char byte = value & 0x7f;
+        value >>= 7;
+        out[n++] = byte | (value != 0 ? 0x80 : 0);
+    } while (value != 0);
+    return n;
+}
+
+static int get_leb128(FILE* in, uint32_t* value) {
+    uint32_t result = 0;
+    for (int shift = 0; shift < 7 * MAX_LEB128_BYTES; shift += 7) {
+        int byte = fgetc(in);
+        if (byte == EOF) {
+            return -1;
+        }
+        result |= (uint32_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+static void write_players(FILE* out, const GameState* state) {
+    for (unsigned int i = 0; i < state->player_count; i++) {
+        FramePlayer p;
+        memset(&p, 0, sizeof(p));
+        memcpy(p.name, state->players[i].name, sizeof(p.name));
+        p.score = state->players[i].score;
+        p.invalid_moves = state->players[i].invalid_moves;
+        p.valid_moves = state->players[i].valid_moves;
+        p.x = state->players[i].x;
+        p.y = state->players[i].y;
+        p.is_blocked = state->players[i].is_blocked;
+        fwrite(&p, sizeof(p), 1, out);
+    }
+}
+
+int frame_writer_open(FrameWriter* writer, const char* path, const GameState* state,
+                      int keyframe_interval) {
+    memset(writer, 0, sizeof(*writer));
+    writer->out = fopen(path, "wb");
+    if (writer->out == NULL) {
+        perror(path);
+        return -1;
+    }
+    
+    writer->keyframe_interval = keyframe_interval > 0 ? keyframe_interval : FRAMES_DEFAULT_KEYFRAME;
+    writer->cells = state->width * state->height;
+    writer->previous = malloc(writer->cells);
+    writer->scratch = malloc((size_t)writer->cells * (MAX_LEB128_BYTES + 1));
+    if (writer->previous == NULL || writer->scratch == NULL) {
+        perror("malloc frame writer");
+        frame_writer_close(writer);
+        return -1;
+    }
+    
+    StreamHeader header = {{'C', 'H', 'F', 'R'}, FRAMES_VERSION, state->width, state->height, 0};
+    if (fwrite(&header, sizeof(header), 1, writer->out) != 1) {
+        frame_writer_close(writer);
+        return -1;
+    }
+    return 0;
+}
+
+int frame_writer_write(FrameWriter* writer, const GameState* state) {
+    bool keyframe = writer->frame_no % writer->keyframe_interval == 0;
+    size_t payload = 0;
+    uint32_t changed = 0;
+    
+    if (keyframe) {
+        for (int i = 0; i < writer->cells; i++) {
+            writer->previous[i] = (int8_t)state->board[i];
+        }
+        memcpy(writer->scratch, writer->previous, writer->cells);
+        payload = writer->cells;
+        changed = writer->cells;
+    } else {
+        int last = 0;
+        for (int i = 0; i < writer->cells; i++) {
+            int8_t value = (int8_t)state->board[i];
+            if (value != writer->previous[i]) {
+                writer->previous[i] = value;
+                payload += put_leb128(writer->scratch + payload, (uint32_t)(i - last));
+                writer->scratch[payload++] = (unsigned char)value;
+                last = i;
+                changed++;
+            }
+        }
+    }
+    
+    FrameHeader header = {keyframe ? FRAME_KEY : FRAME_DELTA, state->game_over,
+                          (uint16_t)state->player_count, writer->frame_no, changed};
+    fwrite(&header, sizeof(header), 1, writer->out);
+    write_players(writer->out, state);
+    fwrite(writer->scratch, 1, payload, writer->out);
+    writer->frame_no++;
+    
+    // Flush per frame so a FIFO reader sees the game live
+    return fflush(writer->out) == 0 ? 0 : -1;
+}
+
+void frame_writer_close(FrameWriter* writer) {
+    if (writer->out != NULL) {
+        fclose(writer->out);
+        writer->out = NULL;
+    }
+    free(writer->previous);
+    free(writer->scratch);
+    writer->previous = NULL;
+    writer->scratch = NULL;
+}
+
+int frame_reader_open(FrameReader* reader, const char* path) {
+    memset(reader, 0, sizeof(*reader));
+    reader->in = fopen(path, "rb");
+    if (reader->in == NULL) {
+        perror(path);
+        return -1;
+    }
+    
+    StreamHeader header;
+    if (fread(&header, sizeof(header), 1, reader->in) != 1 ||
+        memcmp(header.magic, FRAMES_MAGIC, 4) != 0 || header.version != FRAMES_VERSION) {
+        fprintf(stderr, "%s: not a frame stream\n", path);
+        frame_reader_close(reader);
+        return -1;
+    }
+    
+    reader->state_size = sizeof(GameState) + (size_t)header.width * header.height * sizeof(int);
+    reader->state = calloc(1, reader->state_size);
+    if (reader->state == NULL) {
+        perror("calloc frame reader");
+        frame_reader_close(reader);
+        return -1;
+    }
+    reader->state->width = header.width;
+    reader->state->height = header.height;
+    return 0;
+}
+
+int frame_reader_next(FrameReader* reader) {
+    FrameHeader header;
+    GameState* state = reader->state;
+    uint32_t cells = (uint32_t)state->width * state->height;
+    
+    if (fread(&header, sizeof(header), 1, reader->in) != 1) {
+        return 0;
+    }
+    if (header.player_count > 9 || (header.type != FRAME_KEY && header.type != FRAME_DELTA) ||
+        header.changed_cells > cells) {
+        return -1;
+    }
+    
+    state->player_count = header.player_count;
+    state->game_over = header.game_over;
+    for (unsigned int i = 0; i < header.player_count; i++) {
+        FramePlayer p;
+        if (fread(&p, sizeof(p), 1, reader->in) != 1) {
+            return -1;
+        }
+        memcpy(state->players[i].name, p.name, sizeof(p.name));
+        state->players[i].score = p.score;
+        state->players[i].invalid_moves = p.invalid_moves;
+        state->players[i].valid_moves = p.valid_moves;
+        state->players[i].x = p.x;
+        state->players[i].y = p.y;
+        state->players[i].is_blocked = p.is_blocked;
+    }
+    
+    if (header.type == FRAME_KEY) {
+        for (uint32_t i = 0; i < cells; i++) {
+            int value = fgetc(reader->in);
+            if (value == EOF) {
+                return -1;
+            }
+            state->board[i] = (int8_t)value;
+        }
+    } else {
+        uint32_t index = 0;
+        for (uint32_t c = 0; c < header.changed_cells; c++) {
+            uint32_t gap;
+            int value;
+            if (get_leb128(reader->in, &gap) != 0 || (value = fgetc(reader->in)) == EOF) {
+                return -1;
+            }
+            index += gap;
+            if (index >= cells) {
+                return -1;
+            }
+            state->board[index] = (int8_t)value;
+        }
+    }
+    
+    reader->last = header;
+    return 1;
+}
+
+void frame_reader_close(FrameReader* reader) {
+    if (reader->in != NULL) {
+        fclose(reader->in);
+        reader->in = NULL;
+    }
+    free(reader->state);
+    reader->state = NULL;
+}
@@ -0,0 +1,102 @@
+#ifndef FRAMES_H
+#define FRAMES_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "structs.h"
+
+/* Binary frame stream written by vista when VISTA_OUTPUT is set.
+ *
+ * Stream header: "CHFR", version, width, height (all little-endian host order).
+ * Each frame:    FrameHeader, player_count FramePlayer records, then either
+ *   keyframe ('K'): width*height cells, one int8_t each, or
+ *   delta    ('D'): changed_cells pairs of (LEB128 index gap, int8_t value).
+ * Cell values are the board encoding (1..9 reward, <= 0 owner), which fits in a byte.
+ */
+#define FRAMES_MAGIC "CHFR"
+#define FRAMES_VERSION 1
+#define FRAMES_DEFAULT_KEYFRAME 32
+#define FRAME_KEY 'K'
+#define FRAME_DELTA 'D'
+
+typedef struct {
+    uint8_t type;              // FRAME_KEY or FRAME_DELTA
+    uint8_t game_over;         // Game over flag
+    uint16_t player_count;     // Player records that follow
+    uint32_t frame_no;         // Sequence number starting at 0
+    uint32_t changed_cells;    // Cells in the payload
+} FrameHeader;
+
+typedef struct {
+    char name[16];
+    uint32_t score;
+    uint32_t invalid_moves;
+    uint32_t valid_moves;
+    uint16_t x, y;
+    uint8_t is_blocked;
+    uint8_t pad[3];
+} FramePlayer;
+
+typedef struct {
+    FILE* out;                 // Destination file or FIFO
+    int keyframe_interval;     // A keyframe is written every this many frames
+    uint32_t frame_no;         // Next frame number
+    int cells;                 // width * height
+    int8_t* previous;          // Board as of the last frame written
+    unsigned char* scratch;    // Encoded payload of the current frame
+} FrameWriter;
+
+typedef struct {
+    FILE* in;                  // Source stream
+    GameState* state;          // Reconstructed state, updated by every frame
+    size_t state_size;         // Bytes allocated for state
+    FrameHeader last;          // Header of the last frame read
+} FrameReader;
+
+/**
+ * @brief Open a frame stream for writing and emit its header.
+ * @param writer Writer to initialize.
+ * @param path File or FIFO to write to.
+ * @param state Game state the stream describes.
+ * @param keyframe_interval Frames between keyframes (<= 0 selects the default).
+ * @return 0 on success, -1 on error.
+ */
+int frame_writer_open(FrameWriter* writer, const char* path, const GameState* state,
+                      int keyframe_interval);
+
+/**
+ * @brief Append the current state as a keyframe or a delta frame.
+ * @param writer An open writer.
+ * @param state Game state to record.
+ * @return 0 on success, -1 on error.
+ */
+int frame_writer_write(FrameWriter* writer, const GameState* state);
+
+/**
+ * @brief Flush and close a frame stream.
+ * @param writer An open writer.
+ */
+void frame_writer_close(FrameWriter* writer);
+
+/**
+ * @brief Open a frame stream for reading.
+ * @param reader Reader to initialize.
+ * @param path File or FIFO to read from.
+ * @return 0 on success, -1 on error.
+ */
+int frame_reader_open(FrameReader* reader, const char* path);
+
+/**
+ * @brief Read the next frame and apply it to reader->state.
+ * @param reader An open reader.
+ * @return 1 if a frame was read, 0 at end of stream, -1 on a malformed stream.
+ */
+int frame_reader_next(FrameReader* reader);
+
+/**
+ * @brief Close a frame stream and free the reconstructed state.
+ * @param reader An open reader.
+ */
+void frame_reader_close(FrameReader* reader);
+
+#endif // FRAMES_H
@@ -0,0 +1,90 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "hints.h"
+#include "sharedMem.h"
+
+HintTable* hints_create(int player_count) {
+    HintTable* table = (HintTable*)create_shared_memory(NAME_HINTS, sizeof(HintTable));
+    
+    memset(table, 0, sizeof(HintTable));
+    table->player_count = player_count;
+    
+    return table;
+}
+
+void hints_ready(HintTable* table) {
+    __atomic_store_n(&table->magic, HINTS_MAGIC, __ATOMIC_RELEASE);
+}
+
+void hints_destroy(HintTable* table) {
+    if (table != NULL) {
+        close_shared_memory(table, NAME_HINTS, sizeof(HintTable));
+    }
+}
+
+void hints_publish(HintTable* table, int player_idx, const PaddedBoard* board, int x, int y) {
+    MoveHint* hint = &table->players[player_idx];
+    const int* cell = padded_cell(board, x, y);
+    unsigned char mask = 0;
+    
+    // Single writer: readers retry while seq is odd or changes under them
+    __atomic_store_n(&hint->seq, hint->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    hint->x = x;
+    hint->y = y;
+    for (int dir = 0; dir < 8; dir++) {
+        int value = cell[board->dir_offset[dir]]; // Sentinels cover the board edge
+        hint->reward[dir] = value > 0 ? value : 0;
+        mask |= (value > 0) << dir;
+    }
+    hint->free_mask = mask;
+    __atomic_store_n(&hint->seq, hint->seq + 1, __ATOMIC_RELEASE);
+}
+
+const HintTable* hints_attach(void) {
+    int fd = shm_open(NAME_HINTS, O_RDONLY, 0666);
+    if (fd == -1) {
+        return NULL;
+    }
+    
+    void* ptr = mmap(NULL, sizeof(HintTable), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+    
+    const HintTable* table = (const HintTable*)ptr;
+    if (__atomic_load_n(&table->magic, __ATOMIC_ACQUIRE) != HINTS_MAGIC) {
+        munmap(ptr, sizeof(HintTable));
+        return NULL;
+    }
+    return table;
+}
+
+void hints_detach(const HintTable* table) {
+    if (table != NULL) {
+        munmap((void*)table, sizeof(HintTable));
+    }
+}
+
+bool hints_read(const HintTable* table, int player_idx, MoveHint* out) {
+    const MoveHint* hint = &table->players[player_idx];
+    
+    for (int attempt = 0; attempt < HINTS_READ_TRIES; attempt++) {
+        unsigned int seq = __atomic_load_n(&hint->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1) {
+            continue;
+        }
+        memcpy(out, hint, sizeof(*out));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&hint->seq, __ATOMIC_RELAXED) == seq) {
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef HINTS_H
+#define HINTS_H
+
+#include <stdbool.h>
+#include "structs.h"
+#include "board.h"
+
+/* Shared memory segment with per-player move hints published by the master */
+#define NAME_HINTS "/game_hints"
+
+#define HINTS_MAGIC 0x48494e54u       // "HINT"
+#define HINTS_MAX_PLAYERS 9
+#define HINTS_READ_TRIES 8            // Seqlock retries before a reader gives up
+
+/* What a player sees around itself, as of the last move that changed it.
+ * Each slot is one cache line written only by the master, so a player
+ * reading its own slot never shares a line with another player's updates.
+ */
+typedef struct {
+    unsigned int seq;                 // Odd while the master rewrites the slot (seqlock)
+    unsigned short x, y;              // Player position the hint was taken at
+    unsigned char free_mask;          // Bit d set if the neighbour in direction d is free
+    unsigned char reward[8];          // Reward of each neighbour, 0 unless free
+} __attribute__((aligned(CACHE_LINE_SIZE))) MoveHint;
+
+/* Layout of the /game_hints segment */
+typedef struct {
+    unsigned int magic;               // HINTS_MAGIC once every slot is filled
+    unsigned int player_count;        // Number of players
+    MoveHint players[HINTS_MAX_PLAYERS] __attribute__((aligned(CACHE_LINE_SIZE)));
+} HintTable;
+
+STATIC_ASSERT(sizeof(MoveHint) == CACHE_LINE_SIZE, hint_fills_one_line);
+STATIC_ASSERT(offsetof(HintTable, players) % CACHE_LINE_SIZE == 0, hints_start_a_line);
+
+/**
+ * @brief Create and map the hints segment; slots stay empty until published.
+ * @param player_count Number of players in the game.
+ * @return Pointer to the mapped hints.
+ */
+HintTable* hints_create(int player_count);
+
+/**
+ * @brief Mark the table as ready for players; call once every slot was published.
+ * @param table Pointer returned by hints_create().
+ */
+void hints_ready(HintTable* table);
+
+/**
+ * @brief Unmap and unlink the hints segment.
+ * @param table Pointer returned by hints_create().
+ */
+void hints_destroy(HintTable* table);
+
+/**
+ * @brief Recompute one player's hint from the master's padded board.
+ * @param table Pointer to the hints segment.
+ * @param player_idx Player whose slot to rewrite.
+ * @param board Padded mirror of the board.
+ * @param x Player column.
+ * @param y Player row.
+ */
+void hints_publish(HintTable* table, int player_idx, const PaddedBoard* board, int x, int y);
+
+/**
+ * @brief Map an existing hints segment read-only.
+ * @return Pointer to the mapped hints, or NULL if the master does not publish them.
+ */
+const HintTable* hints_attach(void);
+
+/**
+ * @brief Unmap a segment returned by hints_attach().
+ * @param table Mapped hints, may be NULL.
+ */
+void hints_detach(const HintTable* table);
+
+/**
+ * @brief Copy a consistent hint for a player, without any lock.
+ * @param table Mapped hints.
+ * @param player_idx Player whose slot to read.
+ * @param out Copy of the slot.
+ * @return true on success, false if the master kept rewriting the slot.
+ */
+bool hints_read(const HintTable* table, int player_idx, MoveHint* out);
+
+#endif // HINTS_H
\ No newline at end of file
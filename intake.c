@@ -0,0 +1,514 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include "intake.h"
+#include "metrics.h"
+#include "remote.h"
+
+#define STOP_TOKEN INTAKE_MAX_PLAYERS // epoll data / io_uring user_data of the stop eventfd
+#define CONNECTION_TOKEN (STOP_TOKEN + 1) // epoll data of connection c is CONNECTION_TOKEN + c
+
+static void count_syscalls(MoveIntake* intake, unsigned long long n) {
+    __atomic_add_fetch(&intake->syscalls, n, __ATOMIC_RELAXED);
+}
+
+static void queue_push(MoveIntake* intake, const MoveEvent* event) {
+    MoveQueue* queue = &intake->queue;
+    unsigned int tail = queue->tail;
+    
+    // Never full: each player has at most one move and one close in flight
+    queue->events[tail & (MOVE_QUEUE_SIZE - 1)] = *event;
+    __atomic_store_n(&queue->tail, tail + 1, __ATOMIC_RELEASE);
+    __atomic_add_fetch(&intake->events, 1, __ATOMIC_RELAXED);
+    sync_post(&queue->items);
+}
+
+/* epoll backend */
+
+static void epoll_read_player(MoveIntake* intake, int player) {
+    MoveEvent event;
+    unsigned char direction;
+    ssize_t bytes_read = read(intake->fds[player], &direction, 1);
+    
+    count_syscalls(intake, 1);
+    if (bytes_read < 0) {
+        if (errno == EINTR || errno == EAGAIN) {
+            intake_rearm(intake, player, &event);
+        }
+        return;
+    }
+    
+    memset(&event, 0, sizeof(event));
+    event.player = player;
+    event.read_ns = metrics_now_ns();
+    if (bytes_read == 0) {
+        event.closed = true; // Left disarmed: nothing more will come
+    } else {
+        event.direction = direction;
+        ioctl(intake->fds[player], FIONREAD, &event.pending);
+        count_syscalls(intake, 1);
+    }
+    queue_push(intake, &event);
+}
+
+static void push_closed(MoveIntake* intake, int player) {
+    MoveEvent event;
+    
+    memset(&event, 0, sizeof(event));
+    event.player = player;
+    event.read_ns = metrics_now_ns();
+    event.closed = true;
+    queue_push(intake, &event);
+}
+
+/* Take every packet queued on a remote connection and deliver the moves of
+ * the players that are armed. The socket stays registered (level-triggered)
+ * because it serves several players at once.
+ */
+static void epoll_read_connection(MoveIntake* intake, int connection) {
+    RemotePacket packets[REMOTE_RECV_BATCH];
+    int fd = intake->connections[connection];
+    int n = remote_recv(fd, packets, REMOTE_RECV_BATCH, true);
+    
+    count_syscalls(intake, 1);
+    if (n < 0) {
+        return;
+    }
+    if (n == 0) {
+        // Every player on this connection is gone
+        epoll_ctl(intake->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+        count_syscalls(intake, 1);
+        for (int player = 0; player < intake->player_count; player++) {
+            if (intake->remote[player] && intake->fds[player] == fd) {
+                push_closed(intake, player);
+            }
+        }
+        return;
+    }
+    
+    unsigned long long read_ns = metrics_now_ns();
+    for (int i = 0; i < n; i++) {
+        if (packets[i].type != PACKET_MOVES) {
+            continue;
+        }
+        for (int m = 0; m < packets[i].count; m++) {
+            int player = packets[i].slot[m];
+            int expected = 1;
+            
+            // Only the connection that owns the slot may move it, one move per grant
+            if (player >= intake->player_count || !intake->remote[player] || intake->fds[player] != fd ||
+                !__atomic_compare_exchange_n(&intake->armed[player], &expected, 0, false,
+                                             __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+                __atomic_add_fetch(&intake->dropped, 1, __ATOMIC_RELAXED);
+                continue;
+            }
+            MoveEvent event;
+            memset(&event, 0, sizeof(event));
+            event.player = player;
+            event.direction = packets[i].direction[m];
+            event.read_ns = read_ns;
+            queue_push(intake, &event);
+        }
+    }
+}
+
+static void* epoll_loop(void* arg) {
+    MoveIntake* intake = arg;
+    struct epoll_event events[2 * INTAKE_MAX_PLAYERS + 1];
+    
+    for (;;) {
+        int n = epoll_wait(intake->epoll_fd, events, 2 * INTAKE_MAX_PLAYERS + 1, -1);
+        count_syscalls(intake, 1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("epoll_wait");
+            return NULL;
+        }
+        
+        bool ready[INTAKE_MAX_PLAYERS] = {false};
+        bool connection_ready[INTAKE_MAX_PLAYERS] = {false};
+        for (int i = 0; i < n; i++) {
+            if (events[i].data.u32 == STOP_TOKEN) {
+                return NULL;
+            }
+            if (events[i].data.u32 >= CONNECTION_TOKEN) {
+                connection_ready[events[i].data.u32 - CONNECTION_TOKEN] = true;
+            } else {
+                ready[events[i].data.u32] = true;
+            }
+        }
+        
+        for (int player = 0; player < intake->player_count; player++) {
+            if (ready[player]) {
+                epoll_read_player(intake, player);
+            }
+        }
+        for (int c = 0; c < intake->connection_count; c++) {
+            if (connection_ready[c]) {
+                epoll_read_connection(intake, c);
+            }
+        }
+    }
+}
+
+static int epoll_setup(MoveIntake* intake) {
+    struct epoll_event ev;
+    
+    intake->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (intake->epoll_fd < 0) {
+        return -1;
+    }
+    
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.u32 = STOP_TOKEN;
+    if (epoll_ctl(intake->epoll_fd, EPOLL_CTL_ADD, intake->stop_fd, &ev) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < intake->player_count; i++) {
+        if (intake->remote[i]) {
+            continue;
+        }
+        ev.events = EPOLLIN | EPOLLONESHOT;
+        ev.data.u32 = i;
+        if (epoll_ctl(intake->epoll_fd, EPOLL_CTL_ADD, intake->fds[i], &ev) != 0) {
+            return -1;
+        }
+    }
+    for (int c = 0; c < intake->connection_count; c++) {
+        ev.events = EPOLLIN;
+        ev.data.u32 = CONNECTION_TOKEN + c;
+        if (epoll_ctl(intake->epoll_fd, EPOLL_CTL_ADD, intake->connections[c], &ev) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* io_uring backend, through the raw system calls */
+
+static int uring_setup(unsigned int entries, struct io_uring_params* params) {
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int uring_enter(int fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags) {
+    return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, NULL, 0);
+}
+
+/* Queue a read SQE and submit it. The rules thread submits after each move,
+ * the I/O thread only to retry a read that failed transiently.
+ */
+static int uring_submit_read(MoveIntake* intake, int fd, void* buffer, unsigned int length,
+                             unsigned long long user_data) {
+    IntakeRing* ring = &intake->ring;
+    
+    pthread_mutex_lock(&ring->submit_lock);
+    unsigned int tail = *ring->sq_tail;
+    unsigned int index = tail & *ring->sq_mask;
+    struct io_uring_sqe* sqe = &ring->sqes[index];
+    
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = fd;
+    sqe->addr = (unsigned long long)(uintptr_t)buffer;
+    sqe->len = length;
+    sqe->off = (unsigned long long)-1; // Current position: pipes have no offset
+    sqe->user_data = user_data;
+    ring->sq_array[index] = index;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    
+    count_syscalls(intake, 1);
+    int submitted;
+    do {
+        submitted = uring_enter(ring->fd, 1, 0, 0);
+    } while (submitted < 0 && errno == EINTR);
+    pthread_mutex_unlock(&ring->submit_lock);
+    return submitted == 1 ? 0 : -1;
+}
+
+static int uring_submit_player(MoveIntake* intake, int player) {
+    intake->buffered[player] = 0;
+    intake->consumed[player] = 0;
+    return uring_submit_read(intake, intake->fds[player], intake->buffer[player],
+                             INTAKE_READ_BYTES, (unsigned long long)player);
+}
+
+/* Deliver the next buffered byte of a player that owns a completed read */
+static void uring_next_event(MoveIntake* intake, int player, MoveEvent* event) {
+    memset(event, 0, sizeof(*event));
+    event->player = player;
+    event->read_ns = metrics_now_ns();
+    event->direction = intake->buffer[player][intake->consumed[player]++];
+    event->pending = intake->buffered[player] - intake->consumed[player];
+}
+
+/* A failed read that a new one may fix; anything else ends the player */
+static bool uring_transient(int res) {
+    return res == -EINTR || res == -EAGAIN;
+}
+
+static void* uring_loop(void* arg) {
+    MoveIntake* intake = arg;
+    IntakeRing* ring = &intake->ring;
+    bool ended[INTAKE_MAX_PLAYERS] = {false};
+    
+    for (;;) {
+        unsigned int head = *ring->cq_head;
+        unsigned int tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+        
+        if (head == tail) {
+            count_syscalls(intake, 1);
+            if (uring_enter(ring->fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) {
+                // No more completions will come: end every player now rather than at the timeout
+                perror("io_uring_enter");
+                for (int player = 0; player < intake->player_count; player++) {
+                    if (!ended[player]) {
+                        push_closed(intake, player);
+                    }
+                }
+                return NULL;
+            }
+            continue;
+        }
+        
+        // Reap every completion available in one pass
+        for (; head != tail; head++) {
+            const struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+            MoveEvent event;
+            int player = (int)cqe->user_data;
+            
+            if (cqe->user_data == STOP_TOKEN) {
+                __atomic_store_n(ring->cq_head, head + 1, __ATOMIC_RELEASE);
+                return NULL;
+            }
+            if (cqe->res > 0) {
+                intake->buffered[player] = cqe->res;
+                uring_next_event(intake, player, &event);
+            } else if (uring_transient(cqe->res) && uring_submit_player(intake, player) == 0) {
+                continue; // Nothing was read; the player keeps its read in flight
+            } else {
+                // End of file, or a hard read error: either way nothing more will come
+                memset(&event, 0, sizeof(event));
+                event.player = player;
+                event.read_ns = metrics_now_ns();
+                event.closed = true;
+                ended[player] = true;
+            }
+            queue_push(intake, &event);
+        }
+        __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+    }
+}
+
+static void uring_free(MoveIntake* intake) {
+    IntakeRing* ring = &intake->ring;
+    munmap(ring->sqes, ring->sqes_size);
+    munmap(ring->ring_ptr, ring->ring_size);
+    close(ring->fd); // Cancels the reads still in flight
+    ring->fd = -1;
+    pthread_mutex_destroy(&ring->submit_lock);
+}
+
+static int uring_init(MoveIntake* intake) {
+    struct io_uring_params params;
+    IntakeRing* ring = &intake->ring;
+    
+    memset(&params, 0, sizeof(params));
+    ring->fd = uring_setup(INTAKE_RING_ENTRIES, &params);
+    if (ring->fd < 0) {
+        return -1;
+    }
+    if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_RW_CUR_POS)) {
+        close(ring->fd);
+        errno = ENOSYS;
+        return -1;
+    }
+    
+    size_t sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    size_t cq_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->ring_size = sq_size > cq_size ? sq_size : cq_size;
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    
+    ring->ring_ptr = mmap(NULL, ring->ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          ring->fd, IORING_OFF_SQ_RING);
+    void* sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->fd, IORING_OFF_SQES);
+    if (ring->ring_ptr == MAP_FAILED || sqes == MAP_FAILED) {
+        if (ring->ring_ptr != MAP_FAILED) munmap(ring->ring_ptr, ring->ring_size);
+        if (sqes != MAP_FAILED) munmap(sqes, ring->sqes_size);
+        close(ring->fd);
+        return -1;
+    }
+    
+    char* base = ring->ring_ptr;
+    ring->sq_head = (unsigned int*)(base + params.sq_off.head);
+    ring->sq_tail = (unsigned int*)(base + params.sq_off.tail);
+    ring->sq_mask = (unsigned int*)(base + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned int*)(base + params.sq_off.array);
+    ring->cq_head = (unsigned int*)(base + params.cq_off.head);
+    ring->cq_tail = (unsigned int*)(base + params.cq_off.tail);
+    ring->cq_mask = (unsigned int*)(base + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(base + params.cq_off.cqes);
+    ring->sqes = sqes;
+    
+    pthread_mutex_init(&ring->submit_lock, NULL);
+    
+    // One read in flight per player, plus the stop read
+    bool submitted = uring_submit_read(intake, intake->stop_fd, &intake->stop_value,
+                                       sizeof(intake->stop_value), STOP_TOKEN) == 0;
+    for (int i = 0; i < intake->player_count && submitted; i++) {
+        submitted = uring_submit_player(intake, i) == 0;
+    }
+    if (!submitted) {
+        uring_free(intake);
+        return -1;
+    }
+    return 0;
+}
+
+int intake_start(MoveIntake* intake, const int* fds, const bool* remote, int count,
+                 IntakeBackend backend) {
+    void* (*loop)(void*);
+    
+    memset(intake, 0, sizeof(*intake));
+    intake->player_count = count;
+    intake->epoll_fd = -1;
+    intake->ring.fd = -1;
+    for (int i = 0; i < count; i++) {
+        intake->fds[i] = fds[i];
+        intake->remote[i] = remote != NULL && remote[i];
+        if (!intake->remote[i] || fds[i] < 0) {
+            continue; // A remote slot nobody attached to never moves
+        }
+        // Remote players may move as soon as they are assigned
+        intake->armed[i] = 1;
+        
+        bool known = false;
+        for (int c = 0; c < intake->connection_count; c++) {
+            known |= intake->connections[c] == fds[i];
+        }
+        if (!known) {
+            intake->connections[intake->connection_count++] = fds[i];
+        }
+    }
+    sync_init(&intake->queue.items, 0);
+    
+    intake->stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (intake->stop_fd < 0) {
+        return -1;
+    }
+    
+    // io_uring may be missing, disabled by sysctl or blocked by seccomp
+    if (backend == INTAKE_URING && intake->connection_count > 0) {
+        errno = ENOTSUP;
+        return -1;
+    }
+    if (backend != INTAKE_EPOLL && intake->connection_count == 0 && uring_init(intake) == 0) {
+        intake->backend = INTAKE_URING;
+        loop = uring_loop;
+    } else if (backend == INTAKE_URING) {
+        return -1;
+    } else {
+        if (epoll_setup(intake) != 0) {
+            return -1;
+        }
+        intake->backend = INTAKE_EPOLL;
+        loop = epoll_loop;
+    }
+    
+    // Signals stay with the rules thread, which runs the master's handlers
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    int err = pthread_create(&intake->thread, NULL, loop, intake);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    if (err != 0) {
+        errno = err;
+        return -1;
+    }
+    return 0;
+}
+
+static void queue_pop(MoveQueue* queue, MoveEvent* event) {
+    unsigned int head = queue->head;
+    
+    // The semaphore post happens after the release store, so the event is visible
+    __atomic_load_n(&queue->tail, __ATOMIC_ACQUIRE);
+    *event = queue->events[head & (MOVE_QUEUE_SIZE - 1)];
+    __atomic_store_n(&queue->head, head + 1, __ATOMIC_RELEASE);
+}
+
+int intake_next(MoveIntake* intake, MoveEvent* event, const struct timespec* deadline) {
+    if (sync_timedwait(&intake->queue.items, deadline) != 0) {
+        return -1;
+    }
+    queue_pop(&intake->queue, event);
+    return 0;
+}
+
+int intake_poll(MoveIntake* intake, MoveEvent* event) {
+    if (sync_trywait(&intake->queue.items) != 0) {
+        return -1;
+    }
+    queue_pop(&intake->queue, event);
+    return 0;
+}
+
+bool intake_rearm(MoveIntake* intake, int player, MoveEvent* next) {
+    if (intake->remote[player]) {
+        __atomic_store_n(&intake->armed[player], 1, __ATOMIC_RELEASE);
+        return false;
+    }
+    if (intake->backend == INTAKE_URING) {
+        // The rules thread owns the player's buffer until it submits the next read
+        if (intake->consumed[player] < intake->buffered[player]) {
+            uring_next_event(intake, player, next);
+            __atomic_add_fetch(&intake->events, 1, __ATOMIC_RELAXED);
+            return true;
+        }
+        if (uring_submit_player(intake, player) != 0) {
+            perror("io_uring_enter");
+        }
+        return false;
+    }
+    
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN | EPOLLONESHOT;
+    ev.data.u32 = player;
+    epoll_ctl(intake->epoll_fd, EPOLL_CTL_MOD, intake->fds[player], &ev);
+    count_syscalls(intake, 1);
+    return false;
+}
+
+const char* intake_backend_name(const MoveIntake* intake) {
+    return intake->backend == INTAKE_URING ? "io_uring" : "epoll";
+}
+
+void intake_stop(MoveIntake* intake) {
+    uint64_t one = 1;
+    
+    if (write(intake->stop_fd, &one, sizeof(one)) == sizeof(one)) {
+        pthread_join(intake->thread, NULL);
+    }
+    if (intake->backend == INTAKE_URING) {
+        uring_free(intake);
+    } else {
+        close(intake->epoll_fd);
+    }
+    close(intake->stop_fd);
+    sync_destroy(&intake->queue.items);
+}
\ No newline at end of file
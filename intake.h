@@ -0,0 +1,154 @@
+#ifndef INTAKE_H
+#define INTAKE_H
+
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+#include "sync.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+#define INTAKE_MAX_PLAYERS 9
+#define MOVE_QUEUE_SIZE 32      // Power of two; at most one move and one close per player in flight
+#define INTAKE_READ_BYTES 64    // io_uring reads this much per player; extra moves wait in the intake
+#define INTAKE_RING_ENTRIES 16  // io_uring submission queue size (players plus the stop read)
+
+/* How moves are read from the pipes. Remote players' sockets are always
+ * read through epoll, so their presence makes INTAKE_AUTO pick epoll.
+ */
+typedef enum {
+    INTAKE_AUTO,                // io_uring when the kernel allows it, epoll otherwise
+    INTAKE_EPOLL,               // epoll_wait + one read() per move
+    INTAKE_URING                // Read SQEs kept in flight, completions reaped in batches
+} IntakeBackend;
+
+/* A movement request read from a player's pipe or socket, or its end */
+typedef struct {
+    int player;                 // Player index
+    unsigned char direction;    // Requested direction (unchecked)
+    bool closed;                // The player closed its pipe; direction is meaningless
+    int pending;                // Bytes still queued in the pipe after this one (0 for sockets)
+    unsigned long long read_ns; // When the I/O thread read it (CLOCK_MONOTONIC)
+} MoveEvent;
+
+/* Single-producer single-consumer ring: the I/O thread pushes, the rules
+ * thread pops. items counts published events so the consumer can sleep.
+ */
+typedef struct {
+    MoveEvent events[MOVE_QUEUE_SIZE];
+    unsigned int head __attribute__((aligned(64)));   // Next event to pop, owned by the consumer
+    unsigned int tail __attribute__((aligned(64)));   // Next free slot, owned by the producer
+    SyncSem items;
+} MoveQueue;
+
+/* io_uring rings mapped by the intake. The I/O thread is the only reaper,
+ * so the completion ring needs no lock. The rules thread submits the reads,
+ * and the I/O thread resubmits one that failed transiently, so submissions
+ * take submit_lock; it is only contended in that rare case.
+ */
+typedef struct {
+    int fd;
+    pthread_mutex_t submit_lock;
+    unsigned int* sq_head;
+    unsigned int* sq_tail;
+    unsigned int* sq_mask;
+    unsigned int* sq_array;
+    struct io_uring_sqe* sqes;
+    unsigned int* cq_head;
+    unsigned int* cq_tail;
+    unsigned int* cq_mask;
+    struct io_uring_cqe* cqes;
+    void* ring_ptr;               // SQ and CQ rings (single mapping)
+    size_t ring_size;
+    size_t sqes_size;
+} IntakeRing;
+
+/* Reads movement requests on its own thread. Each pipe is read one move at
+ * a time: after a move is delivered, nothing more is taken from that player
+ * until the rules thread calls intake_rearm(), so a player never has more
+ * than one move queued and a flooding player cannot crowd out the others.
+ * Choosing among the queued moves (round-robin) is left to the rules thread.
+ * A socket shared by several remote players is always readable; a move for
+ * a player that already has one in flight breaks the protocol and is dropped.
+ */
+typedef struct {
+    IntakeBackend backend;        // Backend in use, never INTAKE_AUTO once started
+    int player_count;
+    int fds[INTAKE_MAX_PLAYERS];  // Read ends of the player pipes, or remote players' sockets
+    bool remote[INTAKE_MAX_PLAYERS]; // fds[i] is a socket, possibly shared with other players
+    int armed[INTAKE_MAX_PLAYERS]; // Remote players: a move may be delivered (rules thread sets, I/O thread clears)
+    int connections[INTAKE_MAX_PLAYERS]; // Distinct sockets among fds
+    int connection_count;
+    int epoll_fd;
+    int stop_fd;                  // eventfd that tells the thread to exit
+    unsigned long long stop_value; // io_uring: buffer of the stop read
+    IntakeRing ring;
+    unsigned char buffer[INTAKE_MAX_PLAYERS][INTAKE_READ_BYTES]; // io_uring: bytes read per player
+    int buffered[INTAKE_MAX_PLAYERS]; // io_uring: bytes in buffer, owned by whoever holds the player
+    int consumed[INTAKE_MAX_PLAYERS]; // io_uring: bytes of buffer already delivered
+    unsigned long long events;    // Events delivered
+    unsigned long long syscalls;  // System calls made by both threads
+    unsigned long long dropped;   // Remote moves sent while the player had one in flight
+    pthread_t thread;
+    MoveQueue queue;
+} MoveIntake;
+
+/**
+ * @brief Register the pipes and sockets and start the I/O thread.
+ * @param intake Intake to initialize.
+ * @param fds Read ends of the player pipes, or sockets of remote players, indexed by player.
+ * @param remote Which fds are sockets (NULL if none are); players may share one.
+ * @param count Number of players.
+ * @param backend Backend to use; INTAKE_AUTO falls back to epoll if io_uring fails
+ *                or if there are remote players, INTAKE_URING then fails with ENOTSUP.
+ * @return 0 on success, -1 with errno set on failure.
+ */
+int intake_start(MoveIntake* intake, const int* fds, const bool* remote, int count,
+                 IntakeBackend backend);
+
+/**
+ * @brief Take the next event, waiting until the deadline at most.
+ * @param intake A started intake.
+ * @param event Output event.
+ * @param deadline Absolute CLOCK_REALTIME deadline.
+ * @return 0 on success, -1 with errno ETIMEDOUT or EINTR.
+ */
+int intake_next(MoveIntake* intake, MoveEvent* event, const struct timespec* deadline);
+
+/**
+ * @brief Take the next event if one is queued, without waiting.
+ * @param intake A started intake.
+ * @param event Output event.
+ * @return 0 on success, -1 if the queue is empty.
+ */
+int intake_poll(MoveIntake* intake, MoveEvent* event);
+
+/**
+ * @brief Accept the next move from a player whose last event has been handled.
+ *
+ * With io_uring a single read may have brought several moves; the next one
+ * is then returned at once instead of going through the I/O thread. For a
+ * remote player this only re-enables delivery and makes no system call;
+ * call it before granting the player its next move.
+ * @param intake A started intake.
+ * @param player Player index.
+ * @param next Output: the player's next move, when one is already buffered.
+ * @return true if next was filled.
+ */
+bool intake_rearm(MoveIntake* intake, int player, MoveEvent* next);
+
+/**
+ * @brief Name of the backend in use.
+ * @param intake A started intake.
+ * @return "epoll" or "io_uring".
+ */
+const char* intake_backend_name(const MoveIntake* intake);
+
+/**
+ * @brief Stop the I/O thread and release its resources.
+ * @param intake A started intake.
+ */
+void intake_stop(MoveIntake* intake);
+
+#endif // INTAKE_H
\ No newline at end of file
@@ -0,0 +1,105 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stddef.h>
+#include "kernels.h"
+
+// Movement vectors in the master's direction order (UP first, clockwise)
+static const int step[8][2] = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}};
+
+static inline int claim_cell(int* target, int* shared, int mark) {
+    int value = *target;
+    if (value > 0) {
+        *target = mark;
+        *shared = mark;
+    }
+    return value;
+}
+
+static int claim_generic(PaddedBoard* board, int* flat, int x, int y, unsigned char dir, int mark) {
+    int* target = padded_cell(board, x, y) + board->dir_offset[dir];
+    int* shared = flat + (y + step[dir][1]) * board->width + x + step[dir][0];
+    return claim_cell(target, shared, mark);
+}
+
+static bool can_move_generic(const PaddedBoard* board, int x, int y) {
+    const int* cell = padded_cell(board, x, y);
+    for (int dir = 0; dir < 8; dir++) {
+        if (cell[board->dir_offset[dir]] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* One case of the unrolled claim: both offsets fold to constants */
+#define CLAIM_CASE(dir, dx, dy, W) \
+    case dir: return claim_cell(cell + (dy) * ((W) + 2 * KERNEL_BORDER) + (dx), \
+                                shared + (dy) * (W) + (dx), mark);
+
+/* Instantiate claim_WxH() and can_move_WxH(). The height only names the
+ * set: the sentinel border already stops probes at the top and bottom.
+ */
+#define DEFINE_SIZE_KERNELS(W, H)                                                          \
+    static int claim_##W##x##H(PaddedBoard* board, int* flat, int x, int y,                \
+                               unsigned char dir, int mark) {                              \
+        int* cell = board->origin + y * ((W) + 2 * KERNEL_BORDER) + x;                     \
+        int* shared = flat + y * (W) + x;                                                  \
+        switch (dir) {                                                                     \
+            CLAIM_CASE(0, 0, -1, W)                                                        \
+            CLAIM_CASE(1, 1, -1, W)                                                        \
+            CLAIM_CASE(2, 1, 0, W)                                                         \
+            CLAIM_CASE(3, 1, 1, W)                                                         \
+            CLAIM_CASE(4, 0, 1, W)                                                         \
+            CLAIM_CASE(5, -1, 1, W)                                                        \
+            CLAIM_CASE(6, -1, 0, W)                                                        \
+            CLAIM_CASE(7, -1, -1, W)                                                       \
+            default: return BOARD_SENTINEL;                                                \
+        }                                                                                  \
+    }                                                                                      \
+                                                                                           \
+    static bool can_move_##W##x##H(const PaddedBoard* board, int x, int y) {               \
+        enum { S = (W) + 2 * KERNEL_BORDER };                                              \
+        const int* c = board->origin + y * S + x;                                          \
+        return c[-S] > 0 || c[-S + 1] > 0 || c[1] > 0 || c[S + 1] > 0 ||                   \
+               c[S] > 0 || c[S - 1] > 0 || c[-1] > 0 || c[-S - 1] > 0;                     \
+    }
+
+DEFINE_SIZE_KERNELS(10, 10)
+DEFINE_SIZE_KERNELS(20, 20)
+DEFINE_SIZE_KERNELS(64, 64)
+
+#define SIZE_KERNELS(W, H) {W, H, #W "x" #H, claim_##W##x##H, can_move_##W##x##H}
+
+static const KernelSet kernel_table[] = {
+    SIZE_KERNELS(10, 10),
+    SIZE_KERNELS(20, 20),
+    SIZE_KERNELS(64, 64),
+};
+
+static const KernelSet generic_kernels = {0, 0, "generic", claim_generic, can_move_generic};
+
+const KernelSet* kernels_select(const PaddedBoard* board) {
+    if (board->border != KERNEL_BORDER) {
+        return &generic_kernels;
+    }
+    for (size_t i = 0; i < sizeof(kernel_table) / sizeof(kernel_table[0]); i++) {
+        if (kernel_table[i].width == board->width && kernel_table[i].height == board->height) {
+            return &kernel_table[i];
+        }
+    }
+    return &generic_kernels;
+}
+
+const KernelSet* kernels_generic(void) {
+    return &generic_kernels;
+}
+
+bool kernels_specialized(int width, int height) {
+    for (size_t i = 0; i < sizeof(kernel_table) / sizeof(kernel_table[0]); i++) {
+        if (kernel_table[i].width == width && kernel_table[i].height == height) {
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <stdbool.h>
+#include "board.h"
+
+/* Border the specialized kernels are compiled for (single-step probes) */
+#define KERNEL_BORDER 1
+
+/* Per-move board kernels. The generic set reads the stride and direction
+ * offsets from the PaddedBoard; the specialized sets are instantiated for a
+ * few fixed sizes, so every offset is a compile-time constant and the
+ * direction loops are fully unrolled.
+ */
+typedef struct {
+    int width, height;   // Board size the set is compiled for, 0 for the generic set
+    const char* name;
+
+    /* Capture the free neighbour of (x, y) in direction dir (0-7): writes mark
+     * into the padded board and into flat (row-major, width * height).
+     * Returns the previous cell value; nothing is written unless it was > 0.
+     */
+    int (*claim)(PaddedBoard* board, int* flat, int x, int y, unsigned char dir, int mark);
+
+    /* Whether (x, y) has at least one free neighbour */
+    bool (*can_move)(const PaddedBoard* board, int x, int y);
+} KernelSet;
+
+/**
+ * @brief Pick the kernels for a board.
+ * @param board An initialized padded board.
+ * @return The specialized set for its size and border, or the generic set.
+ */
+const KernelSet* kernels_select(const PaddedBoard* board);
+
+/**
+ * @brief Get the generic kernels, regardless of board size.
+ * @return The generic kernel set.
+ */
+const KernelSet* kernels_generic(void);
+
+/**
+ * @brief Check whether a board size has specialized kernels.
+ * @param width Board width.
+ * @param height Board height.
+ * @return true if kernels_select() would not fall back to the generic set.
+ */
+bool kernels_specialized(int width, int height);
+
+#endif // KERNELS_H
\ No newline at end of file
@@ -0,0 +1,439 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <strings.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "log.h"
+
+#define LOG_LINE_BYTES 512
+#define LOG_OUTPUT_BYTES 8192
+#define LOG_LEVELS 5
+
+/* One captured argument, stored with enough width for any conversion */
+typedef union {
+    long long i;
+    unsigned long long u;
+    double d;
+    const void* p;
+    unsigned int text_offset;     // %s: copy stored in the record's text
+} LogArg;
+
+typedef struct {
+    unsigned long long timestamp_ns;
+    const char* fmt;
+    unsigned char level;
+    unsigned char arg_count;
+    unsigned char text_used;
+    LogArg args[LOG_MAX_ARGS];
+    char text[LOG_TEXT_BYTES];
+} LogRecord;
+
+/* Bounded multi-producer queue: a slot may be claimed by a producer when its
+ * sequence equals the claim position, and read by the consumer when it
+ * equals position + 1.
+ */
+typedef struct {
+    unsigned long long sequence;
+    LogRecord record;
+} __attribute__((aligned(64))) LogSlot;
+
+typedef struct {
+    unsigned long long window;    // Second the count belongs to
+    unsigned long long count;
+} RateWindow;
+
+LogLevel log_threshold = LOG_INFO;
+
+static LogSlot ring[LOG_RING_SIZE];
+static unsigned long long enqueue_pos __attribute__((aligned(64)));
+static unsigned long long dequeue_pos __attribute__((aligned(64)));
+static unsigned long long dropped;      // Ring was full
+static unsigned long long suppressed;   // Over the rate limit
+static RateWindow rate_windows[LOG_LEVELS];
+static unsigned long long rate_limit = LOG_DEFAULT_RATE;
+static unsigned long long start_ns;
+static int output_fd = STDERR_FILENO;
+static char log_tag[16] = "log";
+static pthread_t drain_thread;
+static bool running = false;
+static bool stopping = false;
+
+static const char* level_names[LOG_LEVELS] = {"error", "warn", "info", "debug", "trace"};
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void sleep_ms(long ms) {
+    struct timespec ts = {ms / 1000, (ms % 1000) * 1000000L};
+    nanosleep(&ts, NULL);
+}
+
+/* Length modifier of a conversion, collapsed to what decides the argument type */
+typedef enum { LEN_INT, LEN_LONG, LEN_LLONG, LEN_SIZE } LogLength;
+
+/* Parse the conversion starting after '%'. Returns a pointer to the
+ * conversion character and reports the length modifier and '*' count.
+ */
+static const char* parse_spec(const char* p, LogLength* length, int* stars) {
+    *stars = 0;
+    while (*p != '\0' && strchr("-+ #0", *p) != NULL) p++;
+    if (*p == '*') { (*stars)++; p++; }
+    while (*p >= '0' && *p <= '9') p++;
+    if (*p == '.') {
+        p++;
+        if (*p == '*') { (*stars)++; p++; }
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    
+    *length = LEN_INT;
+    if (*p == 'h') {
+        p += (p[1] == 'h') ? 2 : 1;
+    } else if (*p == 'l') {
+        *length = (p[1] == 'l') ? LEN_LLONG : LEN_LONG;
+        p += (p[1] == 'l') ? 2 : 1;
+    } else if (*p == 'j' || *p == 'L') {
+        *length = LEN_LLONG;
+        p++;
+    } else if (*p == 'z' || *p == 't') {
+        *length = LEN_SIZE;
+        p++;
+    }
+    return p;
+}
+
+static void capture_args(LogRecord* rec, const char* fmt, va_list ap) {
+    LogLength length;
+    int stars;
+    
+    rec->arg_count = 0;
+    rec->text_used = 0;
+    for (const char* p = fmt; *p != '\0'; p++) {
+        if (*p != '%') continue;
+        if (p[1] == '%') { p++; continue; }
+        
+        p = parse_spec(p + 1, &length, &stars);
+        if (*p == '\0' || rec->arg_count + stars >= LOG_MAX_ARGS) {
+            return; // The drain thread stops at the same conversion
+        }
+        for (int s = 0; s < stars; s++) {
+            rec->args[rec->arg_count++].i = va_arg(ap, int);
+        }
+        
+        LogArg* arg = &rec->args[rec->arg_count++];
+        switch (*p) {
+            case 'd': case 'i':
+                arg->i = length == LEN_LLONG ? va_arg(ap, long long) :
+                         length == LEN_LONG ? va_arg(ap, long) :
+                         length == LEN_SIZE ? (long long)va_arg(ap, ptrdiff_t) : va_arg(ap, int);
+                break;
+            case 'u': case 'x': case 'X': case 'o': case 'c':
+                arg->u = length == LEN_LLONG ? va_arg(ap, unsigned long long) :
+                         length == LEN_LONG ? va_arg(ap, unsigned long) :
+                         length == LEN_SIZE ? va_arg(ap, size_t) : va_arg(ap, unsigned int);
+                break;
+            case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+                arg->d = va_arg(ap, double);
+                break;
+            case 's': {
+                const char* s = va_arg(ap, const char*);
+                size_t room = LOG_TEXT_BYTES - rec->text_used;
+                size_t len = s != NULL ? strlen(s) : 0;
+                if (room == 0) {
+                    arg->text_offset = LOG_TEXT_BYTES - 1; // Points at the last terminator
+                    break;
+                }
+                if (len >= room) len = room - 1;
+                memcpy(rec->text + rec->text_used, s != NULL ? s : "", len);
+                rec->text[rec->text_used + len] = '\0';
+                arg->text_offset = rec->text_used;
+                rec->text_used += len + 1;
+                break;
+            }
+            default: // %p; %n is never honoured
+                arg->p = va_arg(ap, void*);
+                break;
+        }
+    }
+}
+
+static bool rate_allows(LogLevel level, unsigned long long timestamp_ns) {
+    if (level == LOG_ERROR || rate_limit == 0) {
+        return true;
+    }
+    RateWindow* w = &rate_windows[level];
+    unsigned long long second = timestamp_ns / 1000000000ULL;
+    unsigned long long window = __atomic_load_n(&w->window, __ATOMIC_RELAXED);
+    
+    // Whoever moves the window resets the count; a few records may slip through the race
+    if (window != second &&
+        __atomic_compare_exchange_n(&w->window, &window, second, false,
+                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&w->count, 0, __ATOMIC_RELAXED);
+    }
+    return __atomic_add_fetch(&w->count, 1, __ATOMIC_RELAXED) <= rate_limit;
+}
+
+void log_write(LogLevel level, const char* fmt, ...) {
+    unsigned long long timestamp_ns = now_ns();
+    
+    if (!rate_allows(level, timestamp_ns)) {
+        __atomic_add_fetch(&suppressed, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    
+    // Claim a slot
+    LogSlot* slot;
+    unsigned long long pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+    for (;;) {
+        slot = &ring[pos & (LOG_RING_SIZE - 1)];
+        long long diff = (long long)(__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&enqueue_pos, &pos, pos + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            __atomic_add_fetch(&dropped, 1, __ATOMIC_RELAXED);
+            return;
+        } else {
+            pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+    
+    LogRecord* rec = &slot->record;
+    va_list ap;
+    rec->timestamp_ns = timestamp_ns;
+    rec->fmt = fmt;
+    rec->level = level;
+    va_start(ap, fmt);
+    capture_args(rec, fmt, ap);
+    va_end(ap);
+    
+    // Publish it
+    __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+}
+
+/* Format a record the same way printf would have, one conversion at a time */
+static size_t format_record(const LogRecord* rec, char* out, size_t size) {
+    LogLength length;
+    int stars;
+    int arg = 0;
+    char spec[32];
+    size_t used = snprintf(out, size, "[%11.6f] %-5s %s: ",
+                           (rec->timestamp_ns - start_ns) / 1e9, level_names[rec->level], log_tag);
+    
+    for (const char* p = rec->fmt; *p != '\0' && used < size - 1; p++) {
+        if (*p != '%') {
+            out[used++] = *p;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[used++] = '%';
+            p++;
+            continue;
+        }
+        
+        const char* start = p;
+        p = parse_spec(p + 1, &length, &stars);
+        if (*p == '\0' || arg + stars >= rec->arg_count) {
+            break;
+        }
+        
+        // Rebuild the conversion with '*' replaced by the captured numbers
+        size_t spec_len = 0;
+        for (const char* q = start; q <= p && spec_len < sizeof(spec) - 12; q++) {
+            if (*q == '*') {
+                spec_len += snprintf(spec + spec_len, sizeof(spec) - spec_len, "%d", (int)rec->args[arg++].i);
+            } else {
+                spec[spec_len++] = *q;
+            }
+        }
+        spec[spec_len] = '\0';
+        
+        const LogArg* a = &rec->args[arg++];
+        int n;
+        switch (*p) {
+            case 'd': case 'i':
+                n = length == LEN_LLONG ? snprintf(out + used, size - used, spec, a->i) :
+                    length == LEN_LONG ? snprintf(out + used, size - used, spec, (long)a->i) :
+                    length == LEN_SIZE ? snprintf(out + used, size - used, spec, (ptrdiff_t)a->i) :
+                    snprintf(out + used, size - used, spec, (int)a->i);
+                break;
+            case 'u': case 'x': case 'X': case 'o': case 'c':
+                n = length == LEN_LLONG ? snprintf(out + used, size - used, spec, a->u) :
+                    length == LEN_LONG ? snprintf(out + used, size - used, spec, (unsigned long)a->u) :
+                    length == LEN_SIZE ? snprintf(out + used, size - used, spec, (size_t)a->u) :
+                    snprintf(out + used, size - used, spec, (unsigned int)a->u);
+                break;
+            case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+                n = snprintf(out + used, size - used, spec, a->d);
+                break;
+            case 's':
+                n = snprintf(out + used, size - used, spec, rec->text + a->text_offset);
+                break;
+            case 'p':
+                n = snprintf(out + used, size - used, spec, a->p);
+                break;
+            default:
+                n = 0;
+                break;
+        }
+        used += n > 0 ? (size_t)n : 0;
+        if (used >= size) {
+            used = size - 1;
+        }
+    }
+    
+    out[used++] = '\n';
+    return used;
+}
+
+static void write_all(const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = write(output_fd, data, size);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += n;
+        size -= n;
+    }
+}
+
+/* Single consumer: only the drain thread (or the final drain) calls this */
+static size_t drain(void) {
+    char output[LOG_OUTPUT_BYTES];
+    size_t used = 0;
+    size_t records = 0;
+    
+    for (;;) {
+        LogSlot* slot = &ring[dequeue_pos & (LOG_RING_SIZE - 1)];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != dequeue_pos + 1) {
+            break;
+        }
+        if (used + LOG_LINE_BYTES > sizeof(output)) {
+            write_all(output, used);
+            used = 0;
+        }
+        used += format_record(&slot->record, output + used, LOG_LINE_BYTES);
+        
+        // Hand the slot back to producers one lap ahead
+        __atomic_store_n(&slot->sequence, dequeue_pos + LOG_RING_SIZE, __ATOMIC_RELEASE);
+        __atomic_store_n(&dequeue_pos, dequeue_pos + 1, __ATOMIC_RELEASE);
+        records++;
+    }
+    if (used > 0) {
+        write_all(output, used);
+    }
+    return records;
+}
+
+static void* drain_loop(void* arg) {
+    (void)arg;
+    while (!__atomic_load_n(&stopping, __ATOMIC_ACQUIRE)) {
+        if (drain() == 0) {
+            sleep_ms(LOG_DRAIN_INTERVAL_MS);
+        }
+    }
+    drain();
+    return NULL;
+}
+
+static LogLevel parse_level(const char* name) {
+    for (int i = 0; i < LOG_LEVELS; i++) {
+        if (strcasecmp(name, level_names[i]) == 0) {
+            return (LogLevel)i;
+        }
+    }
+    return LOG_INFO;
+}
+
+void log_init(const char* tag) {
+    const char* level = getenv(LOG_ENV_LEVEL);
+    const char* file = getenv(LOG_ENV_FILE);
+    const char* rate = getenv(LOG_ENV_RATE);
+    
+    snprintf(log_tag, sizeof(log_tag), "%s", tag);
+    if (level != NULL) {
+        log_threshold = parse_level(level);
+    }
+    if (rate != NULL) {
+        rate_limit = strtoull(rate, NULL, 10);
+    }
+    if (file != NULL) {
+        int fd = open(file, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            perror(file);
+        } else {
+            output_fd = fd;
+        }
+    }
+    
+    for (unsigned long long i = 0; i < LOG_RING_SIZE; i++) {
+        ring[i].sequence = i;
+    }
+    enqueue_pos = 0;
+    dequeue_pos = 0;
+    start_ns = now_ns();
+    
+    // The drain thread inherits a full signal mask, so handlers run on the caller's threads
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    int err = pthread_create(&drain_thread, NULL, drain_loop, NULL);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    if (err != 0) {
+        fprintf(stderr, "log: pthread_create: %s\n", strerror(err));
+        return;
+    }
+    running = true;
+}
+
+void log_flush(void) {
+    unsigned long long target = __atomic_load_n(&enqueue_pos, __ATOMIC_ACQUIRE);
+    
+    if (!running) {
+        return;
+    }
+    // Bounded: a producer interrupted between claim and publish would stall the drain
+    for (int waited = 0; waited < LOG_FLUSH_TIMEOUT_MS; waited++) {
+        if ((long long)(__atomic_load_n(&dequeue_pos, __ATOMIC_ACQUIRE) - target) >= 0) {
+            return;
+        }
+        sleep_ms(1);
+    }
+}
+
+void log_shutdown(void) {
+    if (!running) {
+        return;
+    }
+    log_flush();
+    __atomic_store_n(&stopping, true, __ATOMIC_RELEASE);
+    pthread_join(drain_thread, NULL);
+    running = false;
+    
+    if (dropped > 0 || suppressed > 0) {
+        char line[128];
+        int n = snprintf(line, sizeof(line), "log: %llu records dropped (ring full), %llu over the rate limit\n",
+                         dropped, suppressed);
+        write_all(line, n);
+    }
+    if (output_fd != STDERR_FILENO) {
+        close(output_fd);
+        output_fd = STDERR_FILENO;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdbool.h>
+
+#define LOG_RING_SIZE 1024          // Records in flight; must be a power of two
+#define LOG_MAX_ARGS 12             // Conversions per record, '*' widths included
+#define LOG_TEXT_BYTES 64           // Room for copies of %s arguments
+#define LOG_DRAIN_INTERVAL_MS 5     // Drain thread polling period when idle
+#define LOG_FLUSH_TIMEOUT_MS 100    // log_flush() gives up after this long
+#define LOG_DEFAULT_RATE 10000      // Records per second per level (errors are never limited)
+
+/* Environment variables read by log_init(), inherited by spawned children */
+#define LOG_ENV_LEVEL "CHOMP_LOG_LEVEL"  // error, warn, info, debug or trace
+#define LOG_ENV_FILE "CHOMP_LOG_FILE"    // Append to this file instead of stderr
+#define LOG_ENV_RATE "CHOMP_LOG_RATE"    // Records per second per level, 0 for no limit
+
+typedef enum {
+    LOG_ERROR,
+    LOG_WARN,
+    LOG_INFO,
+    LOG_DEBUG,
+    LOG_TRACE
+} LogLevel;
+
+/* Most verbose level that is recorded */
+extern LogLevel log_threshold;
+
+/* Log a printf-style message. Filtered records cost a single comparison;
+ * recorded ones never format, lock or block on the caller's thread.
+ */
+#define LOG(level, ...) \
+    do { \
+        if ((level) <= log_threshold) log_write((level), __VA_ARGS__); \
+    } while (0)
+
+/**
+ * @brief Read the logging environment variables and start the drain thread.
+ * @param tag Name of the process, printed on every line.
+ */
+void log_init(const char* tag);
+
+/**
+ * @brief Append a record to the ring; formatting happens on the drain thread.
+ *
+ * Lock-free and async-signal-safe. The format string must outlive the
+ * process (a literal); %s arguments are copied. Records are dropped, and
+ * counted, when the ring is full or the level's rate limit is exceeded.
+ * @param level Severity of the record.
+ * @param fmt printf-style format string.
+ */
+void log_write(LogLevel level, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+
+/**
+ * @brief Wait until every record written so far has been drained.
+ */
+void log_flush(void);
+
+/**
+ * @brief Drain what is left, report dropped records and stop the drain thread.
+ */
+void log_shutdown(void);
+
+#endif // LOG_H
\ No newline at end of file
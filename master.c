@@ -6,10 +6,19 @@
 // Global variables
 GameState* game_state = NULL;
 GameSync* game_sync = NULL;
+GameMetrics* game_metrics = NULL;
+HintTable* game_hints = NULL;
 PlayerProcess players[MAX_PLAYERS];
 ViewProcess view;
 int player_count = 0;
 size_t game_state_size = 0;
+PaddedBoard padded_board;
+const KernelSet* kernels = NULL;
+Connectivity connectivity;
+MasterOptions master_options;
+Checkpointer checkpointer;
+CheckpointInfo resume_info;
+volatile sig_atomic_t stop_signal = 0;
 
 int main(int argc, char* argv[]) {
     int width = MIN_WIDTH;
@@ -20,16 +29,24 @@ int main(int argc, char* argv[]) {
     char* view_path = NULL;
     char** player_paths = NULL;
     
-    signal(SIGINT, sig_handler);
-    signal(SIGTERM, sig_handler);
+    log_init("master");
+    // No SA_RESTART: blocking waits on the rules thread return EINTR and see the flag
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = sig_handler;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
     
     parse_args(argc, argv, &width, &height, &delay, &timeout, &seed, 
-               &view_path, &player_paths, &player_count);
+               &view_path, &player_paths, &player_count, &master_options);
     
     if (player_count < 1) {
         fprintf(stderr, "Error: At least one player must be specified\n");
         exit(EXIT_FAILURE);
     }
+    trace_init("master");
+    trace_name_thread("rules");
     
     // Print game parameters
     printf("width: %d\n", width);
@@ -38,31 +55,81 @@ int main(int argc, char* argv[]) {
     printf("timeout: %d\n", timeout);
     printf("seed: %u\n", seed);
     printf("view: %s\n", view_path ? view_path : "None");
+    printf("fast_forward: %s\n", master_options.fast_forward ? "on" : "off");
+    printf("checkpoint: %s\n", master_options.checkpoint_path ? master_options.checkpoint_path : "None");
+    printf("restore: %s\n", master_options.restore_path ? master_options.restore_path : "None");
+    printf("intake: %s\n", master_options.intake == INTAKE_EPOLL ? "epoll" :
+           master_options.intake == INTAKE_URING ? "io_uring" : "auto");
+    printf("socket: %s\n", master_options.socket_path);
+    printf("trace: %s\n", trace_enabled ? getenv(TRACE_ENV) : "None");
+    if (master_options.pacing == PACING_RATE) {
+        printf("pacing: %.1f moves/s\n", master_options.pace_rate);
+    } else {
+        printf("pacing: %s\n", master_options.pacing == PACING_OFF ? "off" : "delay");
+    }
+    printf("games: %d\n", master_options.games);
     printf("num_players: %d\n", player_count);
     for (int i = 0; i < player_count; i++) {
         printf("Player %d: %s\n", i, player_paths[i]);
     }
     
-    init_game_state(width, height, player_count, seed);
+    if (master_options.restore_path != NULL) {
+        restore_game_state(master_options.restore_path, player_count);
+    } else {
+        init_game_state(width, height, player_count, seed);
+    }
     init_game_sync(player_count);
-    place_players_on_board();
+    game_metrics = metrics_create(player_count);
+    if (master_options.restore_path == NULL) {
+        place_players_on_board();
+    }
+    init_padded_board();
+    printf("kernels: %s\n", kernels->name);
+    init_connectivity();
+    init_hints();
+    init_checkpoints();
+    apply_placement();
+    enter_rt_mode();
     
     view.binary_path = view_path;
     for (int i = 0; i < player_count; i++) {
         players[i].binary_path = player_paths[i];
+        players[i].remote = strcmp(player_paths[i], REMOTE_SLOT) == 0;
+        players[i].socket_fd = -1;
     }
-    start_players_and_view(width, height);
+    listen_for_remote_players();
+    start_players_and_view(game_state->width, game_state->height);
     
-    sleep(1); // Give processes time to initialize
+    wait_for_participants(READY_TIMEOUT_MS);
+    attach_remote_players(timeout * TO_MILI_SEC);
     
     game_loop(delay, timeout);
+    while (next_pooled_game(seed)) {
+        game_loop(delay, timeout);
+    }
+    release_participants();
     display_winner();
+    report_board_stats();
+    report_regions();
+    report_sync_stats();
+    metrics_print_summary(game_metrics, stdout);
+    report_pacing();
+    report_pool();
+    report_checkpoints();
+    report_migrations();
     
     // Wait for all child processes and print results
     int status;
     pid_t pid;
     
     for (int i = 0; i < player_count; i++) {
+        if (players[i].remote) {
+            printf("Player %s (%d) was remote (pid %d) with a score of %u/%u/%u\n",
+                   game_state->players[i].name, i, players[i].pid,
+                   game_state->players[i].score, game_state->players[i].valid_moves,
+                   game_state->players[i].invalid_moves);
+            continue;
+        }
         pid = waitpid(players[i].pid, &status, 0);
         if (pid >= 0) {
             if (WIFEXITED(status)) {
@@ -90,6 +157,7 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    merge_trace();
     cleanup();
     
     free(view_path);
@@ -31,7 +31,7 @@ void display_winner(void) {
         }
     }
     
-    printf("\nGame over! Final scores:\n");
+    printf("\nGame over! Final scores%s:\n", master_options.games > 1 ? " (last game)" : "");
     for (int i = 0; i < player_count; i++) {
         printf("%s: %u points (%u valid moves, %u invalid moves)\n",
                game_state->players[i].name, game_state->players[i].score,
@@ -68,11 +68,14 @@ void display_winner(void) {
 
 void parse_args(int argc, char* argv[], int* width, int* height, int* delay, 
                 int* timeout, unsigned int* seed, char** view_path, 
-                char*** player_paths, int* player_count) {
+                char*** player_paths, int* player_count, MasterOptions* options) {
     int opt;
     bool p_flag = false;
     
-    while ((opt = getopt(argc, argv, "w:h:d:t:s:v:p")) != -1) {
+    placement_init(&options->placement);
+    options->socket_path = REMOTE_DEFAULT_PATH;
+    options->games = 1;
+    while ((opt = getopt(argc, argv, "w:h:d:t:s:v:fc:r:i:a:n:R:u:T:P:g:p")) != -1) {
         switch (opt) {
             case 'w':
                 *width = atoi(optarg);
@@ -94,11 +97,80 @@ void parse_args(int argc, char* argv[], int* width, int* height, int* delay,
             case 'v':
                 *view_path = strdup(optarg);
                 break;
+            case 'f':
+                options->fast_forward = true;
+                break;
+            case 'c':
+                options->checkpoint_path = optarg;
+                break;
+            case 'u':
+                options->socket_path = optarg;
+                break;
+            case 'r':
+                options->restore_path = optarg;
+                break;
+            case 'a':
+                if (placement_parse(&options->placement, optarg) != 0) {
+                    fprintf(stderr, "Error: -a takes auto, none or role=cpus (role: master, view, players, p0..p8)\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
+            case 'n':
+                options->placement.numa_node = atoi(optarg);
+                break;
+            case 'R': {
+                RtMode mode;
+                if (rt_parse_mode(optarg, &mode) != 0) {
+                    fprintf(stderr, "Error: -R takes off, lock or fifo\n");
+                    exit(EXIT_FAILURE);
+                }
+                // Children spawned later read the same variable
+                setenv(RT_ENV, optarg, 1);
+                break;
+            }
+            case 'P':
+                if (strcmp(optarg, "off") == 0) {
+                    options->pacing = PACING_OFF;
+                } else {
+                    options->pace_rate = atof(optarg);
+                    if (options->pace_rate <= 0) {
+                        fprintf(stderr, "Error: -P takes a positive number of moves per second, or off\n");
+                        exit(EXIT_FAILURE);
+                    }
+                    options->pacing = PACING_RATE;
+                }
+                break;
+            case 'g':
+                options->games = atoi(optarg);
+                if (options->games < 1) {
+                    fprintf(stderr, "Error: -g takes a positive number of games\n");
+                    exit(EXIT_FAILURE);
+                }
+                if (options->games > 1) {
+                    setenv(POOL_ENV, "1", 1); // Players that know the protocol park between games
+                }
+                break;
+            case 'T':
+                // The view and player_simple trace too, and leave their spans for the master
+                setenv(TRACE_ENV, optarg, 1);
+                break;
+            case 'i':
+                if (strcmp(optarg, "epoll") == 0) {
+                    options->intake = INTAKE_EPOLL;
+                } else if (strcmp(optarg, "io_uring") == 0) {
+                    options->intake = INTAKE_URING;
+                } else if (strcmp(optarg, "auto") == 0) {
+                    options->intake = INTAKE_AUTO;
+                } else {
+                    fprintf(stderr, "Error: -i takes auto, epoll or io_uring\n");
+                    exit(EXIT_FAILURE);
+                }
+                break;
             case 'p':
                 p_flag = true;
                 break;
             default:
-                fprintf(stderr, "Usage: %s [-w width] [-h height] [-d delay] [-t timeout] [-s seed] [-v view] -p player1 player2 ...\n", argv[0]);
+                fprintf(stderr, "Usage: %s [-w width] [-h height] [-d delay] [-t timeout] [-s seed] [-v view] [-f] [-c checkpoint] [-r checkpoint] [-i auto|epoll|io_uring] [-a role=cpus] [-n node] [-R off|lock|fifo] [-u socket] [-T trace.json] [-P rate|off] [-g games] -p player1|@ player2|@ ...\n", argv[0]);
                 exit(EXIT_FAILURE);
         }
     }
@@ -126,6 +198,22 @@ void parse_args(int argc, char* argv[], int* width, int* height, int* delay,
     
     for (int i = 0; i < *player_count; i++) {
         (*player_paths)[i] = strdup(argv[optind + i]);
+        if (options->games > 1 && strcmp(argv[optind + i], REMOTE_SLOT) == 0) {
+            fprintf(stderr, "Error: -g does not support remote players\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+void generate_board(GameState* state, unsigned int seed) {
+    int width = state->width;
+    int height = state->height;
+    
+    srand(seed);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            state->board[y * width + x] = (rand() % 9) + 1;
+        }
     }
 }
 
@@ -139,12 +227,7 @@ void init_game_state(int width, int height, int player_count, unsigned int seed)
     game_state->player_count = player_count;
     game_state->game_over = false;
     
-    srand(seed);
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            game_state->board[y * width + x] = (rand() % 9) + 1;
-        }
-    }
+    generate_board(game_state, seed);
     
     for (int i = 0; i < player_count; i++) {
         snprintf(game_state->players[i].name, PLAYER_NAME_MAX_LENGTH, "Player %d", i + 1);
@@ -155,20 +238,140 @@ void init_game_state(int width, int height, int player_count, unsigned int seed)
     }
 }
 
+void restore_game_state(const char* path, int player_count) {
+    CheckpointHeader header;
+    
+    if (checkpoint_read_header(path, &header) != 0) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    if ((int)header.player_count != player_count) {
+        fprintf(stderr, "Error: %s holds a game with %u players, %d given\n",
+                path, header.player_count, player_count);
+        exit(EXIT_FAILURE);
+    }
+    
+    // Read straight into the new segment
+    game_state_size = header.state_size;
+    game_state = (GameState*)create_shared_memory(NAME_BOARD, game_state_size);
+    if (checkpoint_read_state(path, game_state, game_state_size) != 0) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    game_state->game_over = false;
+    game_state->pool_closed = false;
+    game_state->game_id = 0;
+    resume_info = header.info;
+    
+    printf("Restored %dx%d game from %s (%.1f s played)\n", game_state->width,
+           game_state->height, path, header.info.elapsed_ns / 1e9);
+}
+
+void init_checkpoints(void) {
+    if (master_options.checkpoint_path == NULL) {
+        return;
+    }
+    if (checkpoint_init(&checkpointer, game_state_size) != 0) {
+        perror("checkpoint");
+        exit(EXIT_FAILURE);
+    }
+}
+
+void apply_placement(void) {
+    Placement* placement = &master_options.placement;
+    char cpus[128];
+    
+    placement_resolve(placement, player_count);
+    if (placement_apply_self(placement) != 0) {
+        perror("sched_setaffinity");
+    }
+    if (placement->has_master) {
+        placement_format_cpus(&placement->master, cpus, sizeof(cpus));
+        printf("master cpus: %s\n", cpus);
+    }
+    if (placement->has_view && view.binary_path != NULL) {
+        placement_format_cpus(&placement->view, cpus, sizeof(cpus));
+        printf("view cpus: %s\n", cpus);
+    }
+    for (int i = 0; i < player_count; i++) {
+        if (placement->has_player[i]) {
+            placement_format_cpus(&placement->players[i], cpus, sizeof(cpus));
+            printf("player %d cpus: %s\n", i, cpus);
+        }
+    }
+    
+    // Move the pages the master already touched; later faults follow the policy
+    if (placement->numa_node >= 0) {
+        if (placement_bind_memory(game_state, game_state_size, placement->numa_node) != 0 ||
+            placement_bind_memory(game_sync, sizeof(GameSync), placement->numa_node) != 0 ||
+            placement_bind_memory(game_metrics, sizeof(GameMetrics), placement->numa_node) != 0 ||
+            placement_bind_memory(game_hints, sizeof(HintTable), placement->numa_node) != 0) {
+            perror("mbind");
+        } else {
+            printf("shared memory bound to node %d\n", placement->numa_node);
+        }
+    }
+}
+
+void enter_rt_mode(void) {
+    if (rt_mode() == RT_OFF) {
+        return;
+    }
+    
+    rt_prefault(game_state, game_state_size);
+    rt_prefault(game_sync, sizeof(GameSync));
+    rt_prefault(game_metrics, sizeof(GameMetrics));
+    rt_prefault(game_hints, sizeof(HintTable));
+    RtStatus status = rt_enter(RT_PRIORITY_MASTER);
+    
+    printf("rt: mode=%s mlock=%s sched=%s\n", rt_mode_name(status.mode),
+           status.locked_future ? "all" : status.locked ? "current" : "no",
+           status.fifo ? "fifo" : "other");
+    if (status.mode == RT_FIFO && !status.fifo) {
+        fprintf(stderr, "Warning: SCHED_FIFO not available (%s), using normal scheduling\n",
+                strerror(status.fifo_error));
+    }
+    if (!status.locked) {
+        fprintf(stderr, "Warning: mlockall failed, pages were only prefaulted\n");
+    }
+}
+
+void report_migrations(void) {
+    printf("migrations: master=%lld", placement_migrations(0));
+    if (view.binary_path != NULL && view.pid > 0) {
+        printf(" view=%lld", placement_migrations(view.pid));
+    }
+    for (int i = 0; i < player_count; i++) {
+        printf(" player%d=%lld", i, placement_migrations(players[i].pid));
+    }
+    printf("\n");
+}
+
+void report_checkpoints(void) {
+    if (master_options.checkpoint_path == NULL) {
+        return;
+    }
+    printf("checkpoints: written=%lu skipped=%lu failed=%lu max_pause_us=%.1f\n",
+           checkpointer.written, checkpointer.skipped, checkpointer.failed,
+           checkpointer.max_pause_ns / 1000.0);
+}
+
 void init_game_sync(int player_count) {
     game_sync = (GameSync*)create_shared_memory(NAME_SYNC, sizeof(GameSync));
     
-    sem_init(&game_sync->view_update_sem, 1, 0);
-    sem_init(&game_sync->view_done_sem, 1, 0);
-    sem_init(&game_sync->master_access_mutex, 1, 1);
-    sem_init(&game_sync->game_state_mutex, 1, 1);
-    sem_init(&game_sync->reader_count_mutex, 1, 1);
+    sync_init(&game_sync->view_update_sem, 0);
+    sync_init(&game_sync->view_done_sem, 0);
+    sync_init(&game_sync->master_access_mutex, 1);
+    sync_init(&game_sync->game_state_mutex, 1);
+    sync_init(&game_sync->reader_count_mutex, 1);
+    sync_init(&game_sync->ready_sem, 0);
     
     game_sync->readers_count = 0;
+    game_sync->generation = 0;
     
     for (int i = 0; i < player_count; i++) {
-        sem_init(&game_sync->player_move_sem[i], 1, 0);
-        sem_post(&game_sync->player_move_sem[i]); // Allow first move
+        sync_init(&game_sync->player_move_sem[i], 0);
+        sync_post(&game_sync->player_move_sem[i]); // Allow first move
     }
 }
 
@@ -206,234 +409,870 @@ void place_players_on_board(void) {
     }
 }
 
+static pid_t spawn_child(const char* path, char* width_str, char* height_str,
+                         posix_spawn_file_actions_t* actions, const cpu_set_t* cpus) {
+    pid_t pid;
+    cpu_set_t saved;
+    char* argv[] = {(char*)path, width_str, height_str, NULL};
+
+    // The child inherits the spawning thread's affinity
+    bool pinned = placement_spawn_begin(cpus, &saved);
+    int err = posix_spawn(&pid, path, actions, NULL, argv, environ);
+    if (pinned) {
+        placement_spawn_end(&saved);
+    }
+    if (err != 0) {
+        fprintf(stderr, "posix_spawn %s: %s\n", path, strerror(err));
+        exit(EXIT_FAILURE);
+    }
+    return pid;
+}
+
+static void start_view(char* width_str, char* height_str) {
+    view.pid = spawn_child(view.binary_path, width_str, height_str, NULL,
+                           master_options.placement.has_view ? &master_options.placement.view : NULL);
+}
+
+static void start_player(int i, char* width_str, char* height_str) {
+    // O_CLOEXEC keeps every other player's pipe out of the spawned children
+    if (pipe2(players[i].pipe_fd, O_CLOEXEC) == -1) {
+        perror("pipe");
+        exit(EXIT_FAILURE);
+    }
+    
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, players[i].pipe_fd[WRITE_END], STDOUT_FILENO);
+    
+    pid_t pid = spawn_child(players[i].binary_path, width_str, height_str, &actions,
+                            master_options.placement.has_player[i] ?
+                            &master_options.placement.players[i] : NULL);
+    posix_spawn_file_actions_destroy(&actions);
+    
+    players[i].pid = pid;
+    close(players[i].pipe_fd[WRITE_END]);
+    
+    game_state->players[i].pid = pid;
+}
+
 void start_players_and_view(int width, int height) {
+    char width_str[16], height_str[16];
+    sprintf(width_str, "%d", width);
+    sprintf(height_str, "%d", height);
+
     if (view.binary_path != NULL) {
-        pid_t pid = fork();
-        if (pid == 0) {
-            char width_str[16], height_str[16];
-            sprintf(width_str, "%d", width);
-            sprintf(height_str, "%d", height);
-            
-            execl(view.binary_path, view.binary_path, width_str, height_str, NULL);
-            
-            perror("execl view");
-            exit(EXIT_FAILURE);
-        } else if (pid > 0) {
-            view.pid = pid;
-        } else {
-            perror("fork view");
-            exit(EXIT_FAILURE);
+        start_view(width_str, height_str);
+    }
+    
+    for (int i = 0; i < player_count; i++) {
+        if (players[i].remote) {
+            continue; // Attaches through the socket instead
+        }
+        start_player(i, width_str, height_str);
+    }
+}
+
+/* Count posts of ready_sem, up to expected or until timeout_ms have passed */
+static int wait_ready(int expected, int timeout_ms) {
+    struct timespec deadline;
+    
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout_ms / TO_MILI_SEC;
+    deadline.tv_nsec += (long)(timeout_ms % TO_MILI_SEC) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+    
+    int ready = 0;
+    while (ready < expected) {
+        if (sync_timedwait(&game_sync->ready_sem, &deadline) == 0) {
+            ready++;
+        } else if (errno != EINTR) {
+            break; // ETIMEDOUT: start with whoever is ready
         }
     }
+    return ready;
+}
+
+void wait_for_participants(int timeout_ms) {
+    int expected = view.binary_path != NULL ? 1 : 0;
+    for (int i = 0; i < player_count; i++) {
+        expected += players[i].remote ? 0 : 1;
+    }
     
+    int ready = wait_ready(expected, timeout_ms);
+    if (ready < expected) {
+        LOG(LOG_WARN, "only %d/%d processes ready after %d ms, starting anyway",
+            ready, expected, timeout_ms);
+    }
+}
+
+static int remote_listener = -1;
+
+void listen_for_remote_players(void) {
+    bool any_remote = false;
     for (int i = 0; i < player_count; i++) {
-        if (pipe(players[i].pipe_fd) == -1) {
-            perror("pipe");
-            exit(EXIT_FAILURE);
+        any_remote |= players[i].remote;
+    }
+    if (!any_remote) {
+        return;
+    }
+    
+    remote_listener = remote_listen(master_options.socket_path);
+    if (remote_listener < 0) {
+        perror(master_options.socket_path);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/* Seqlock writer side: readers taking snapshot_window() retry while the
+ * generation is odd or changes under them.
+ */
+static void begin_state_write(void) {
+    __atomic_store_n(&game_sync->generation, game_sync->generation + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void end_state_write(void) {
+    __atomic_store_n(&game_sync->generation, game_sync->generation + 1, __ATOMIC_RELEASE);
+}
+
+/* Set is_blocked for the flagged players under the writer lock and inside a
+ * generation bump, like any other state change readers may have snapshotted.
+ */
+static void block_players(const bool* newly_blocked) {
+    sync_wait(&game_sync->master_access_mutex);
+    sync_wait(&game_sync->game_state_mutex);
+    sync_post(&game_sync->master_access_mutex);
+    begin_state_write();
+    
+    for (int i = 0; i < player_count; i++) {
+        if (newly_blocked[i]) {
+            game_state->players[i].is_blocked = true;
+        }
+    }
+    
+    end_state_write();
+    sync_post(&game_sync->game_state_mutex);
+}
+
+/* Set game_over the same way: readers copy it into their windows, so it must
+ * not change under a snapshot they already validated.
+ */
+static void publish_game_over(void) {
+    sync_wait(&game_sync->master_access_mutex);
+    sync_wait(&game_sync->game_state_mutex);
+    sync_post(&game_sync->master_access_mutex);
+    begin_state_write();
+    __atomic_store_n(&game_state->game_over, true, __ATOMIC_RELEASE);
+    end_state_write();
+    sync_post(&game_sync->game_state_mutex);
+}
+
+/* Read a connection's hello and give it as many free remote slots as it asks for */
+static int assign_remote_slots(int fd) {
+    RemotePacket hello, assign;
+    struct pollfd pfd = {fd, POLLIN, 0};
+    
+    // A client that connects but never says hello must not hold up the game
+    if (poll(&pfd, 1, READY_TIMEOUT_MS) != 1 || remote_recv(fd, &hello, 1, true) != 1 ||
+        hello.type != PACKET_HELLO) {
+        return 0;
+    }
+    
+    memset(&assign, 0, sizeof(assign));
+    assign.type = PACKET_ASSIGN;
+    assign.width = game_state->width;
+    assign.height = game_state->height;
+    pid_t pid = remote_peer_pid(fd);
+    for (int i = 0; i < player_count && assign.count < hello.count; i++) {
+        if (players[i].remote && players[i].socket_fd < 0) {
+            assign.slot[assign.count++] = i;
+        }
+    }
+    if (assign.count == 0 || remote_send(fd, &assign) != 0) {
+        return 0;
+    }
+    
+    for (int i = 0; i < assign.count; i++) {
+        int slot = assign.slot[i];
+        players[slot].socket_fd = fd;
+        players[slot].pid = pid;
+        game_state->players[slot].pid = pid;
+    }
+    LOG(LOG_INFO, "remote process %d attached to %d slot(s)", pid, assign.count);
+    return assign.count;
+}
+
+void attach_remote_players(int timeout_ms) {
+    int missing = 0;
+    
+    if (remote_listener < 0) {
+        return;
+    }
+    for (int i = 0; i < player_count; i++) {
+        missing += players[i].remote ? 1 : 0;
+    }
+    
+    unsigned long long deadline_ns = metrics_now_ns() + (unsigned long long)timeout_ms * 1000000ULL;
+    while (missing > 0) {
+        long long left_ms = ((long long)deadline_ns - (long long)metrics_now_ns()) / 1000000LL;
+        struct pollfd pfd = {remote_listener, POLLIN, 0};
+        if (left_ms <= 0) {
+            break;
+        }
+        int ready = poll(&pfd, 1, (int)left_ms);
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            break;
         }
         
-        pid_t pid = fork();
-        if (pid == 0) {
-            close(players[i].pipe_fd[READ_END]);
-            
-            for (int j = 0; j < player_count; j++) {
-                if (j != i) {
-                    close(players[j].pipe_fd[READ_END]);
-                    close(players[j].pipe_fd[WRITE_END]);
-                }
+        int fd = accept4(remote_listener, NULL, NULL, SOCK_CLOEXEC);
+        if (fd < 0) {
+            continue;
+        }
+        int assigned = assign_remote_slots(fd);
+        if (assigned == 0) {
+            close(fd);
+        }
+        missing -= assigned;
+    }
+    
+    if (missing > 0) {
+        LOG(LOG_WARN, "%d remote slot(s) not attached after %d ms, they start blocked", missing, timeout_ms);
+        bool unattached[MAX_PLAYERS];
+        for (int i = 0; i < player_count; i++) {
+            unattached[i] = players[i].remote && players[i].socket_fd < 0;
+        }
+        block_players(unattached);
+    }
+}
+
+/* Grants owed to remote players, sent as one packet per connection */
+static bool grant_due[MAX_PLAYERS];
+
+void init_hints(void) {
+    game_hints = hints_create(player_count);
+    for (int i = 0; i < player_count; i++) {
+        hints_publish(game_hints, i, &padded_board, game_state->players[i].x, game_state->players[i].y);
+    }
+    hints_ready(game_hints);
+}
+
+/* A capture changes the mover's neighbourhood and that of every player
+ * next to the captured cell; nobody else's hint can change.
+ */
+static void refresh_hints(int mover) {
+    int x = game_state->players[mover].x;
+    int y = game_state->players[mover].y;
+    
+    for (int i = 0; i < player_count; i++) {
+        int dx = abs(game_state->players[i].x - x);
+        int dy = abs(game_state->players[i].y - y);
+        if (i == mover || (dx <= 1 && dy <= 1)) {
+            hints_publish(game_hints, i, &padded_board, game_state->players[i].x, game_state->players[i].y);
+        }
+    }
+}
+
+/* Let a player send its next move: spawned players wait on their semaphore,
+ * remote ones hear about it in their connection's next grant packet.
+ */
+static void grant_move(int player) {
+    if (players[player].remote) {
+        grant_due[player] = !game_state->players[player].is_blocked;
+    } else {
+        sync_post(&game_sync->player_move_sem[player]);
+    }
+}
+
+static void flush_grants(void) {
+    for (int i = 0; i < player_count; i++) {
+        if (!grant_due[i]) {
+            continue;
+        }
+        
+        RemotePacket grant;
+        memset(&grant, 0, sizeof(grant));
+        grant.type = PACKET_GRANT;
+        for (int j = i; j < player_count; j++) {
+            if (grant_due[j] && players[j].socket_fd == players[i].socket_fd) {
+                grant.slot[grant.count++] = j;
+                grant_due[j] = false;
             }
-            
-            if (dup2(players[i].pipe_fd[WRITE_END], STDOUT_FILENO) == -1) {
-                perror("dup2");
-                exit(EXIT_FAILURE);
+        }
+        if (remote_send(players[i].socket_fd, &grant) != 0) {
+            LOG(LOG_DEBUG, "grant to remote process %d failed: %s", players[i].pid, strerror(errno));
+        }
+    }
+}
+
+/* Tell every remote connection the game is over */
+static void end_remote_players(void) {
+    RemotePacket end;
+    
+    memset(&end, 0, sizeof(end));
+    end.type = PACKET_END;
+    for (int i = 0; i < player_count; i++) {
+        bool first = players[i].socket_fd >= 0;
+        for (int j = 0; j < i && first; j++) {
+            first = players[j].socket_fd != players[i].socket_fd;
+        }
+        if (first) {
+            remote_send(players[i].socket_fd, &end);
+        }
+    }
+}
+
+static void close_remote_players(void) {
+    for (int i = 0; i < player_count; i++) {
+        int fd = players[i].socket_fd;
+        if (fd < 0) {
+            continue;
+        }
+        for (int j = i; j < player_count; j++) {
+            if (players[j].socket_fd == fd) {
+                players[j].socket_fd = -1;
             }
-            
-            close(players[i].pipe_fd[WRITE_END]);
-            
-            char width_str[16], height_str[16];
-            sprintf(width_str, "%d", width);
-            sprintf(height_str, "%d", height);
-            
-            execl(players[i].binary_path, players[i].binary_path, width_str, height_str, NULL);
-            
-            perror("execl player");
-            exit(EXIT_FAILURE);
-        } else if (pid > 0) {
-            players[i].pid = pid;
-            close(players[i].pipe_fd[WRITE_END]);
-            
-            game_state->players[i].pid = pid;
-        } else {
-            perror("fork player");
-            exit(EXIT_FAILURE);
         }
+        close(fd);
+    }
+    if (remote_listener >= 0) {
+        close(remote_listener);
+        unlink(master_options.socket_path);
+        remote_listener = -1;
+    }
+}
+
+/* True when no trailing player could reach the leader's score even by
+ * collecting every cell still reachable from its position.
+ */
+static bool winner_settled(void) {
+    unsigned int leader = 0;
+    for (int i = 1; i < player_count; i++) {
+        if (game_state->players[i].score > game_state->players[leader].score) {
+            leader = i;
+        }
+    }
+    
+    for (int i = 0; i < player_count; i++) {
+        int cells;
+        long reward;
+        if ((unsigned int)i == leader) {
+            continue;
+        }
+        connectivity_reach(&connectivity, game_state->players[i].x, game_state->players[i].y,
+                           &cells, &reward);
+        if (game_state->players[i].score + reward >= game_state->players[leader].score) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* The view handshake and the delay after a valid move run on their own
+ * thread, so the rules thread can finish the move's bookkeeping meanwhile.
+ * The next move is only applied once the presenter is idle again, which
+ * keeps the original order: move, frame, delay, next move.
+ *
+ * With -P rate the delay is replaced by a sleep until frame k's deadline,
+ * epoch + k * period. The deadlines are absolute, so the time spent on the
+ * move and the frame counts toward the period and errors do not add up.
+ */
+typedef struct {
+    pthread_t thread;
+    SyncSem request;          // A frame is wanted
+    SyncSem idle;             // The frame and its delay are done
+    int delay;
+    unsigned long long period_ns; // Frame period with -P rate, 0 otherwise
+    bool enabled;             // There is a view or a delay to wait for
+    bool busy;                // A frame was requested and not waited for yet (rules thread only)
+    bool stop;
+    unsigned long long frame_moves; // Moves handled when the frame was requested (for tracing)
+    
+    // Pacing statistics, written by the presenter thread and read after it stops
+    unsigned long long frames;      // Valid moves presented (or applied, with no presenter)
+    unsigned long long epoch_ns;    // Origin of the -P deadline grid
+    unsigned long long first_ns;    // When the first frame's wait ended
+    unsigned long long last_ns;     // When the last frame's wait ended
+    unsigned long long error_ns;    // Sum of |wake - deadline| (-P rate)
+    unsigned long long max_error_ns;
+    unsigned long long overruns;    // Frames that missed their slot by a whole period or more
+} Presenter;
+
+static Presenter presenter;
+
+/* Pacing statistics of every game so far; pooled games (-g) add up */
+typedef struct {
+    unsigned long long frames;
+    unsigned long long intervals;   // Frames after each game's first, which only starts its clock
+    unsigned long long span_ns;     // First to last frame, summed over the games
+    unsigned long long error_ns;
+    unsigned long long max_error_ns;
+    unsigned long long overruns;
+} PacingTotals;
+
+static PacingTotals pacing_totals;
+
+// Virtual trace tracks with the time each player's move waited in the intake queue
+static const char* queue_track_names[MAX_PLAYERS] = {
+    "queue p0", "queue p1", "queue p2", "queue p3", "queue p4",
+    "queue p5", "queue p6", "queue p7", "queue p8"
+};
+
+/* Wait for the current frame's slot on the -P grid. A frame that misses its
+ * slot by a whole period moves the grid instead of making the next ones
+ * catch up in a burst.
+ */
+static void pace_frame(void) {
+    struct timespec deadline;
+    unsigned long long now = metrics_now_ns();
+    
+    if (presenter.frames == 0) {
+        presenter.epoch_ns = now;
+    }
+    unsigned long long target = presenter.epoch_ns + (presenter.frames + 1) * presenter.period_ns;
+    if (now >= target + presenter.period_ns) {
+        presenter.overruns++;
+        presenter.epoch_ns = now - (presenter.frames + 1) * presenter.period_ns;
+        target = now;
+    }
+    
+    deadline.tv_sec = target / 1000000000ULL;
+    deadline.tv_nsec = target % 1000000000ULL;
+    unsigned long long late = rt_sleep_until(&deadline);
+    if (now < target) {
+        metrics_max(&game_metrics->global.max_sleep_late_ns, late); // Oversleep, not overrun
+    }
+    presenter.error_ns += late;
+    if (late > presenter.max_error_ns) {
+        presenter.max_error_ns = late;
+    }
+}
+
+static void* present_loop(void* arg) {
+    (void)arg;
+    trace_name_thread("presenter");
+    for (;;) {
+        sync_wait(&presenter.request);
+        if (__atomic_load_n(&presenter.stop, __ATOMIC_ACQUIRE)) {
+            return NULL;
+        }
+        
+        if (view.binary_path != NULL) {
+            unsigned long long view_ns = metrics_now_ns();
+            trace_flow("frame", true, TRACE_FRAME_FLOW(presenter.frame_moves), view_ns);
+            sync_post(&game_sync->view_update_sem);
+            sync_wait(&game_sync->view_done_sem);
+            unsigned long long done_ns = metrics_now_ns();
+            trace_span("view_handshake", view_ns, done_ns, presenter.frame_moves);
+            metrics_add(&game_metrics->global.view_wait_ns, done_ns - view_ns);
+            metrics_add(&game_metrics->global.view_frames, 1);
+        }
+        if (presenter.period_ns > 0) {
+            unsigned long long sleep_ns = TRACE_NOW();
+            pace_frame();
+            trace_span("pace", sleep_ns, TRACE_NOW(), presenter.frame_moves);
+        } else if (presenter.delay > 0) {
+            struct timespec deadline;
+            unsigned long long sleep_ns = TRACE_NOW();
+            rt_deadline_after(&deadline, presenter.delay * 1000000LL);
+            metrics_max(&game_metrics->global.max_sleep_late_ns, rt_sleep_until(&deadline));
+            trace_span("delay", sleep_ns, TRACE_NOW(), presenter.frame_moves);
+        }
+        presenter.last_ns = metrics_now_ns();
+        if (presenter.frames++ == 0) {
+            presenter.first_ns = presenter.last_ns;
+        }
+        
+        sync_post(&presenter.idle);
+    }
+}
+
+static void presenter_start(int delay) {
+    memset(&presenter, 0, sizeof(presenter));
+    presenter.delay = master_options.pacing == PACING_DELAY ? delay : 0;
+    if (master_options.pacing == PACING_RATE) {
+        presenter.period_ns = (unsigned long long)(1e9 / master_options.pace_rate);
+    }
+    presenter.enabled = view.binary_path != NULL || presenter.delay > 0 || presenter.period_ns > 0;
+    if (!presenter.enabled) {
+        return;
+    }
+    
+    sync_init(&presenter.request, 0);
+    sync_init(&presenter.idle, 0);
+    
+    sigset_t all, old;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    int err = pthread_create(&presenter.thread, NULL, present_loop, NULL);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    if (err != 0) {
+        fprintf(stderr, "pthread_create: %s\n", strerror(err));
+        exit(EXIT_FAILURE);
     }
 }
 
+static void presenter_submit(unsigned long long moves) {
+    if (presenter.enabled) {
+        presenter.busy = true;
+        presenter.frame_moves = moves;
+        sync_post(&presenter.request);
+    } else {
+        // Nothing to wait for: the move is done as soon as it is applied
+        presenter.last_ns = metrics_now_ns();
+        if (presenter.frames++ == 0) {
+            presenter.first_ns = presenter.last_ns;
+        }
+    }
+}
+
+static void presenter_wait_idle(void) {
+    if (presenter.busy) {
+        sync_wait(&presenter.idle);
+        presenter.busy = false;
+    }
+}
+
+/* Add the finished game's pacing to the run's totals */
+static void pacing_add_game(void) {
+    pacing_totals.frames += presenter.frames;
+    if (presenter.frames > 1) {
+        pacing_totals.intervals += presenter.frames - 1;
+        pacing_totals.span_ns += presenter.last_ns - presenter.first_ns;
+    }
+    pacing_totals.error_ns += presenter.error_ns;
+    if (presenter.max_error_ns > pacing_totals.max_error_ns) {
+        pacing_totals.max_error_ns = presenter.max_error_ns;
+    }
+    pacing_totals.overruns += presenter.overruns;
+}
+
+static void presenter_stop(void) {
+    pacing_add_game();
+    if (!presenter.enabled) {
+        return;
+    }
+    presenter_wait_idle();
+    __atomic_store_n(&presenter.stop, true, __ATOMIC_RELEASE);
+    sync_post(&presenter.request);
+    pthread_join(presenter.thread, NULL);
+    sync_destroy(&presenter.request);
+    sync_destroy(&presenter.idle);
+}
+
+/* The view leaves as soon as it sees game_over, so a frame still in flight
+ * has to be shown first or the final handshake would wait for nobody.
+ */
+static void end_game(void) {
+    presenter_wait_idle();
+    publish_game_over();
+}
+
+/* Keep a queued event until its turn comes; pipe ends block the player at once */
+static void stash_event(const MoveEvent* event, MoveEvent* pending, bool* has_pending) {
+    if (event->closed) {
+        LOG(LOG_WARN, "Player %d has closed its pipe", event->player);
+        bool closed[MAX_PLAYERS] = {false};
+        closed[event->player] = true;
+        block_players(closed);
+    } else if (!game_state->players[event->player].is_blocked) {
+        // Blocked players' requests are ignored, and their pipe stays disarmed
+        pending[event->player] = *event;
+        has_pending[event->player] = true;
+    }
+}
+
+static long ms_since(const struct timeval* since) {
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return (now.tv_sec - since->tv_sec) * 1000 + (now.tv_usec - since->tv_usec) / 1000;
+}
+
 void game_loop(int delay, int timeout) {
-    fd_set read_fds;
-    struct timeval tv, current_time, last_valid_move_time;
-    int max_fd = -1;
+    struct timeval last_valid_move_time;
+    struct timespec deadline;
+    MoveIntake intake;
+    MoveEvent event;
+    MoveEvent pending[MAX_PLAYERS];
+    bool has_pending[MAX_PLAYERS] = {false};
+    int fds[MAX_PLAYERS];
+    bool remote[MAX_PLAYERS];
     
     gettimeofday(&last_valid_move_time, NULL);
     
-    int start_index = 0; // For round-robin player processing
+    // A restored game picks up its idle timer and game clock where they were
+    last_valid_move_time.tv_sec -= resume_info.idle_ms / TO_MILI_SEC;
+    last_valid_move_time.tv_usec -= (resume_info.idle_ms % TO_MILI_SEC) * 1000;
+    if (last_valid_move_time.tv_usec < 0) {
+        last_valid_move_time.tv_sec--;
+        last_valid_move_time.tv_usec += 1000000;
+    }
+    
+    int start_index = resume_info.start_index % player_count; // For round-robin player processing
+    unsigned long long move_granted_ns[MAX_PLAYERS];
+    unsigned long long last_checkpoint_ns;
+    unsigned long long queue_free_ns[MAX_PLAYERS] = {0}; // End of each player's last queued span
+    unsigned long long handled_moves = 0;                // Frame ids shared with the view
+    
+    // Pooled games add up: start_ns times the whole run, resets included.
+    // Latencies are per game: every player was just granted its first move
+    unsigned long long game_start_ns = metrics_now_ns();
+    if (game_state->game_id == 0) {
+        game_metrics->start_ns = game_start_ns - resume_info.elapsed_ns;
+    }
+    last_checkpoint_ns = game_start_ns;
+    for (int i = 0; i < player_count; i++) {
+        move_granted_ns[i] = game_start_ns;
+        fds[i] = players[i].remote ? players[i].socket_fd : players[i].pipe_fd[READ_END];
+        remote[i] = players[i].remote;
+        handled_moves += game_state->players[i].valid_moves + game_state->players[i].invalid_moves;
+        trace_name_track(i, queue_track_names[i]);
+    }
+    
+    // The I/O thread reads the pipes; this thread applies the rules
+    if (intake_start(&intake, fds, remote, player_count, master_options.intake) != 0) {
+        perror("intake");
+        exit(EXIT_FAILURE);
+    }
+    presenter_start(delay);
     
     while (!game_state->game_over) {
-        // Check if all players are blocked
+        if (stop_signal != 0) {
+            LOG(LOG_WARN, "Received signal %d. Cleaning up and exiting...", (int)stop_signal);
+            if (presenter.busy && view.binary_path != NULL) {
+                sync_post(&game_sync->view_done_sem); // The view may have died of the same signal
+            }
+            end_game();
+            break;
+        }
+        
+        // Check if all players are blocked; the checks only read, the lock is taken to publish
         int blocked_players = 0;
+        bool newly_blocked[MAX_PLAYERS] = {false};
+        bool any_newly_blocked = false;
         for (int i = 0; i < player_count; i++) {
             if (game_state->players[i].is_blocked) {
                 blocked_players++;
             } else if (!can_player_move(i)) {
-                game_state->players[i].is_blocked = true;
+                newly_blocked[i] = true;
+                any_newly_blocked = true;
                 blocked_players++;
             }
         }
+        if (any_newly_blocked) {
+            block_players(newly_blocked);
+        }
         
         if (blocked_players == player_count) {
-            printf("Game over: All players are blocked\n");
-            game_state->game_over = true;
+            LOG(LOG_INFO, "Game over: All players are blocked");
+            end_game();
+            break;
+        }
+        
+        // Check for timeout
+        if (ms_since(&last_valid_move_time) > timeout * TO_MILI_SEC) {
+            LOG(LOG_INFO, "Game over: Timeout reached (%d seconds without valid moves)", timeout);
+            end_game();
             break;
         }
         
-        // Calculate max file descriptor for select
-        max_fd = -1;
+        // Wait for player input only when nothing is queued, at most until the timeout would fire
+        bool any_pending = false;
         for (int i = 0; i < player_count; i++) {
-            if (players[i].pipe_fd[READ_END] > max_fd) {
-                max_fd = players[i].pipe_fd[READ_END];
+            // A move queued before its player got blocked is never taken
+            has_pending[i] &= !game_state->players[i].is_blocked;
+            any_pending |= has_pending[i];
+        }
+        if (!any_pending) {
+            flush_grants(); // Nothing else to do: let the remote players move
+            deadline.tv_sec = last_valid_move_time.tv_sec + timeout;
+            deadline.tv_nsec = last_valid_move_time.tv_usec * 1000L;
+            unsigned long long idle_ns = TRACE_NOW();
+            int got = intake_next(&intake, &event, &deadline);
+            trace_span("wait_input", idle_ns, TRACE_NOW(), 0);
+            if (got != 0) {
+                if (errno == EINTR) continue; // Interrupted by signal
+                LOG(LOG_INFO, "Game over: Timeout reached (%d seconds without valid moves)", timeout);
+                end_game();
+                break;
             }
+            stash_event(&event, pending, has_pending);
+        }
+        while (intake_poll(&intake, &event) == 0) {
+            stash_event(&event, pending, has_pending);
         }
         
-        // Set up select timeout
-        tv.tv_sec = timeout;
-        tv.tv_usec = 0;
+        // Pick among the players with a move ready in round-robin fashion
+        int player_idx = -1;
+        for (int i = 0; i < player_count && player_idx < 0; i++) {
+            int candidate = (start_index + i) % player_count;
+            if (has_pending[candidate] && !game_state->players[candidate].is_blocked) {
+                player_idx = candidate;
+            }
+        }
+        if (player_idx < 0) {
+            continue;
+        }
+        event = pending[player_idx];
+        has_pending[player_idx] = false;
+        start_index = (start_index + 1) % player_count;
         
-        // Prepare fd_set for select
-        FD_ZERO(&read_fds);
-        int active_players = 0;
-        for (int i = 0; i < player_count; i++) {
-            if (!game_state->players[i].is_blocked) {
-                FD_SET(players[i].pipe_fd[READ_END], &read_fds);
-                active_players++;
+        // The previous valid move's frame and delay come first
+        unsigned long long view_wait_ns = TRACE_NOW();
+        bool view_busy = presenter.busy;
+        if (presenter.busy) {
+            flush_grants();
+        }
+        presenter_wait_idle();
+        
+        unsigned long long dequeued_ns = metrics_now_ns();
+        unsigned long long seq = game_state->players[player_idx].valid_moves +
+                                 game_state->players[player_idx].invalid_moves;
+        if (view_busy) {
+            trace_span("wait_view", view_wait_ns, dequeued_ns, handled_moves);
+        }
+        // A move read along with the previous one only starts queueing once that one is taken
+        trace_track_span(player_idx, "queued",
+                         event.read_ns > queue_free_ns[player_idx] ? event.read_ns : queue_free_ns[player_idx],
+                         dequeued_ns, seq);
+        queue_free_ns[player_idx] = dequeued_ns;
+        
+        // Process the movement
+        sync_wait(&game_sync->master_access_mutex);
+        sync_wait(&game_sync->game_state_mutex);
+        sync_post(&game_sync->master_access_mutex);
+        
+        unsigned long long locked_ns = metrics_now_ns();
+        metrics_add(&game_metrics->global.lock_wait_ns, locked_ns - dequeued_ns);
+        metrics_add(&game_metrics->global.lock_acquisitions, 1);
+        begin_state_write();
+        
+        unsigned int score_before = game_state->players[player_idx].score;
+        unsigned long long apply_ns = TRACE_NOW();
+        trace_flow("move", false, TRACE_MOVE_FLOW(player_idx, seq), apply_ns);
+        bool valid = process_movement(player_idx, event.direction);
+        trace_span("process_movement", apply_ns, TRACE_NOW(), seq);
+        handled_moves++;
+        if (valid) {
+            refresh_hints(player_idx); // Before the grant, so the mover's next turn sees it
+            connectivity_capture(&connectivity, game_state->players[player_idx].x,
+                                 game_state->players[player_idx].y,
+                                 (int)(game_state->players[player_idx].score - score_before));
+        }
+        
+        // Check if any player is now blocked
+        blocked_players = 0;
+        for (int j = 0; j < player_count; j++) {
+            if (game_state->players[j].is_blocked) {
+                blocked_players++;
+            } else if (!can_player_move(j)) {
+                game_state->players[j].is_blocked = true;
+                blocked_players++;
             }
         }
         
-        if (active_players == 0) {
-            printf("Game over: No active players remain\n");
-            game_state->game_over = true;
-            break;
+        // Copy the state while still holding the lock; the disk write happens in a child
+        bool checkpoint_due = master_options.checkpoint_path != NULL &&
+            locked_ns - last_checkpoint_ns >= CHECKPOINT_INTERVAL_MS * 1000000ULL;
+        if (checkpoint_due) {
+            CheckpointInfo info;
+            info.start_index = start_index;
+            info.idle_ms = valid ? 0 : ms_since(&last_valid_move_time);
+            info.elapsed_ns = locked_ns - game_metrics->start_ns;
+            checkpoint_capture(&checkpointer, game_state, &info);
         }
         
-        // Check for timeout
-        gettimeofday(&current_time, NULL);
-        long elapsed_time = (current_time.tv_sec - last_valid_move_time.tv_sec) * 1000 +
-                           (current_time.tv_usec - last_valid_move_time.tv_usec) / 1000;
+        end_state_write();
+        sync_post(&game_sync->game_state_mutex);
+        trace_span("lock_wait", dequeued_ns, locked_ns, seq);
+        trace_span("apply", locked_ns, TRACE_NOW(), seq);
         
-        if (elapsed_time > timeout * TO_MILI_SEC) {
-            printf("Game over: Timeout reached (%d seconds without valid moves)\n", timeout);
-            game_state->game_over = true;
-            break;
+        // Signal the player that their move was processed, and take its next one
+        unsigned long long request_ns = event.read_ns - move_granted_ns[player_idx];
+        move_granted_ns[player_idx] = metrics_now_ns();
+        grant_move(player_idx); // Remote grants go out after the rearm below
+        metrics_add(&game_metrics->global.iteration_ns, move_granted_ns[player_idx] - dequeued_ns);
+        metrics_max(&game_metrics->global.max_iteration_ns, move_granted_ns[player_idx] - dequeued_ns);
+        if (!game_state->players[player_idx].is_blocked &&
+            intake_rearm(&intake, player_idx, &event)) {
+            stash_event(&event, pending, has_pending); // Already read along with the last one
         }
         
-        // Wait for player input
-        int ready = select(max_fd + 1, &read_fds, NULL, NULL, &tv);
-        if (ready == -1) {
-            if (errno == EINTR) continue; // Interrupted by signal
-            perror("select");
-            break;
-        } else if (ready == 0) {
-            printf("Game over: No player input received within timeout\n");
-            game_state->game_over = true;
-            break;
+        // If valid movement, update last valid move time and show it
+        if (valid) {
+            gettimeofday(&last_valid_move_time, NULL);
+            presenter_submit(handled_moves);
         }
         
-        // Process player inputs in round-robin fashion
-        bool any_processed = false;
+        // Bookkeeping overlaps with the view and the player's next decision
+        metrics_record_move(game_metrics, player_idx, valid, request_ns, event.pending);
+        LOG(LOG_TRACE, "move player=%d dir=%u valid=%d x=%u y=%u score=%u pending=%d",
+            player_idx, event.direction, valid, game_state->players[player_idx].x,
+            game_state->players[player_idx].y, game_state->players[player_idx].score, event.pending);
         
-        for (int i = 0; i < player_count; i++) {
-            int player_idx = (start_index + i) % player_count;
-            
-            if (game_state->players[player_idx].is_blocked) {
-                continue;
-            }
-            
-            if (FD_ISSET(players[player_idx].pipe_fd[READ_END], &read_fds)) {
-                unsigned char direction;
-                ssize_t bytes_read = read(players[player_idx].pipe_fd[READ_END], &direction, 1);
-                
-                if (bytes_read > 0) {
-                    // Process the movement
-                    sem_wait(&game_sync->master_access_mutex);
-                    sem_wait(&game_sync->game_state_mutex);
-                    sem_post(&game_sync->master_access_mutex);
-                    
-                    bool valid = process_movement(player_idx, direction);
-                    
-                    // Check if any player is now blocked
-                    blocked_players = 0;
-                    for (int j = 0; j < player_count; j++) {
-                        if (game_state->players[j].is_blocked) {
-                            blocked_players++;
-                        } else if (!can_player_move(j)) {
-                            game_state->players[j].is_blocked = true;
-                            blocked_players++;
-                        }
-                    }
-                    
-                    sem_post(&game_sync->game_state_mutex);
-                    
-                    // Signal the player that their move was processed
-                    sem_post(&game_sync->player_move_sem[player_idx]);
-                    
-                    // If valid movement, update last valid move time
-                    if (valid) {
-                        gettimeofday(&last_valid_move_time, NULL);
-                        
-                        if (view.binary_path != NULL) {
-                            sem_post(&game_sync->view_update_sem);
-                            sem_wait(&game_sync->view_done_sem);
-                        }
-                        
-                        usleep(delay * 1000);
-                    }
-                    
-                    any_processed = true;
-                    
-                    if (blocked_players == player_count) {
-                        printf("Game over: All players are blocked\n");
-                        game_state->game_over = true;
-                        break;
-                    }
-                    
-                    break; // Process one player per iteration
-                } else if (bytes_read == 0) {
-                    printf("Player %d has closed its pipe\n", player_idx);
-                    game_state->players[player_idx].is_blocked = true;
-                }
+        if (checkpoint_due) {
+            if (checkpoint_flush(&checkpointer, master_options.checkpoint_path) != 0) {
+                LOG(LOG_DEBUG, "checkpoint not started (%lu skipped so far)", checkpointer.skipped);
             }
+            last_checkpoint_ns = locked_ns;
         }
         
-        // Update starting index for next round
-        if (any_processed) {
-            start_index = (start_index + 1) % player_count;
+        if (blocked_players == player_count) {
+            LOG(LOG_INFO, "Game over: All players are blocked");
+            end_game();
+            break;
         }
         
-        usleep(1000); // Small delay to prevent CPU hogging
+        // Regions only ever split, so once every player is alone it stays that way
+        if (master_options.fast_forward && valid && player_count > 1 &&
+            connectivity_isolated(&connectivity, game_state) && winner_settled()) {
+            LOG(LOG_INFO, "Game over: Players are confined to separate regions and the winner is settled");
+            end_game();
+            break;
+        }
     }
     
     // Game has ended
-    game_state->game_over = true;
+    presenter_stop();
+    intake_stop(&intake);
+    LOG(LOG_INFO, "intake: backend=%s events=%llu io_syscalls=%llu (%.2f per event)",
+        intake_backend_name(&intake), intake.events, intake.syscalls,
+        intake.events > 0 ? (double)intake.syscalls / intake.events : 0.0);
+    if (intake.dropped > 0) {
+        LOG(LOG_WARN, "intake: %llu remote moves dropped (sent without a grant)", intake.dropped);
+    }
+    log_flush(); // Let the game-over reason come out before the final report
+    if (!game_state->game_over) {
+        publish_game_over();
+    }
+    game_metrics->end_ns = metrics_now_ns();
+    __atomic_store_n(&game_metrics->game_over, true, __ATOMIC_RELAXED);
     
     // Signal all players to wake them up from sem_wait
     for (int i = 0; i < player_count; i++) {
-        sem_post(&game_sync->player_move_sem[i]);
+        sync_post(&game_sync->player_move_sem[i]);
     }
+    end_remote_players();
     
     // Notify view of the final game state
-    if (view.binary_path != NULL) {
-        sem_post(&game_sync->view_update_sem);
-        sem_wait(&game_sync->view_done_sem);
+    if (view.binary_path != NULL && stop_signal == 0) {
+        sync_post(&game_sync->view_update_sem);
+        sync_wait(&game_sync->view_done_sem);
+    }
+}
+
+void release_participants(void) {
+    // Pooled players are parked rather than exiting; let them go
+    __atomic_store_n(&game_state->pool_closed, true, __ATOMIC_RELEASE);
+    for (int i = 0; i < player_count; i++) {
+        if (!players[i].remote) {
+            sync_post(&game_sync->player_move_sem[i]);
+        }
     }
     
     // Give players a chance to exit cleanly
@@ -441,7 +1280,7 @@ void game_loop(int delay, int timeout) {
     
     // Force terminate any processes that didn't exit
     for (int i = 0; i < player_count; i++) {
-        if (players[i].pid > 0) {
+        if (players[i].pid > 0 && !players[i].remote) {
             kill(players[i].pid, SIGTERM);
         }
     }
@@ -451,100 +1290,353 @@ void game_loop(int delay, int timeout) {
     }
 }
 
-bool process_movement(int player_idx, unsigned char direction) {
-    bool result = false;
+/* Results of a pooled run (-g) */
+typedef struct {
+    int played;                   // Games finished
+    int wins[MAX_PLAYERS];        // Games each player won or tied for first
+    int respawned;                // Players that exited at game over and were spawned again
+} PoolStats;
+
+static PoolStats pool;
+
+static void record_game_result(void) {
+    unsigned int best = 0;
+    
+    for (int i = 0; i < player_count; i++) {
+        if (game_state->players[i].score > best) {
+            best = game_state->players[i].score;
+        }
+    }
+    for (int i = 0; i < player_count; i++) {
+        pool.wins[i] += game_state->players[i].score == best;
+    }
+    pool.played++;
+    
+    if (master_options.games > 1) {
+        printf("game %d/%d scores:", pool.played, master_options.games);
+        for (int i = 0; i < player_count; i++) {
+            printf(" %u", game_state->players[i].score);
+        }
+        printf("\n");
+    }
+}
+
+/* Wait until every player has parked (posted ready_sem) or exited. Marks
+ * the ones that exited, and returns how many did.
+ */
+static int collect_players(bool* exited) {
+    int parked = 0, gone = 0;
+    unsigned long long give_up_ns = metrics_now_ns() + READY_TIMEOUT_MS * 1000000ULL;
+    
+    while (parked + gone < player_count && metrics_now_ns() < give_up_ns) {
+        if (wait_ready(1, 10) == 1) {
+            parked++;
+        }
+        for (int i = 0; i < player_count; i++) {
+            if (!exited[i] && waitpid(players[i].pid, NULL, WNOHANG) == players[i].pid) {
+                exited[i] = true;
+                gone++;
+            }
+        }
+    }
+    if (parked + gone < player_count) {
+        LOG(LOG_WARN, "pool: only %d/%d players parked or exited, starting the next game anyway",
+            parked + gone, player_count);
+    }
+    return gone;
+}
+
+/* Drop whatever a player wrote after its last move was read */
+static void drain_pipe(int fd) {
+    char junk[64];
+    int pending = 0;
+    
+    while (ioctl(fd, FIONREAD, &pending) == 0 && pending > 0) {
+        if (read(fd, junk, pending < (int)sizeof(junk) ? pending : (int)sizeof(junk)) <= 0) {
+            break;
+        }
+    }
+}
+
+/* Fresh board and scores on the same segments. The players are parked and
+ * the view has exited, so nothing reads the state meanwhile.
+ */
+static void reset_game(unsigned int seed) {
+    begin_state_write();
+    generate_board(game_state, seed);
+    for (int i = 0; i < player_count; i++) {
+        game_state->players[i].score = 0;
+        game_state->players[i].valid_moves = 0;
+        game_state->players[i].invalid_moves = 0;
+        game_state->players[i].is_blocked = false;
+    }
+    place_players_on_board();
+    __atomic_store_n(&game_state->game_over, false, __ATOMIC_RELEASE);
+    __atomic_store_n(&game_state->game_id, game_state->game_id + 1, __ATOMIC_RELEASE);
+    end_state_write();
+    
+    padded_board_load(&padded_board, game_state->board);
+    init_connectivity();
+    for (int i = 0; i < player_count; i++) {
+        hints_publish(game_hints, i, &padded_board, game_state->players[i].x, game_state->players[i].y);
+    }
+    memset(&resume_info, 0, sizeof(resume_info));
+    game_metrics->end_ns = 0;
+    __atomic_store_n(&game_metrics->game_over, false, __ATOMIC_RELAXED);
+}
+
+bool next_pooled_game(unsigned int seed) {
+    bool exited[MAX_PLAYERS] = {false};
+    char width_str[16], height_str[16];
+    
+    record_game_result();
+    if (pool.played >= master_options.games || stop_signal != 0) {
+        return false;
+    }
+    
+    int gone = collect_players(exited);
+    if (view.binary_path != NULL) {
+        // The view is not pooled: it left after the final frame and starts over
+        waitpid(view.pid, NULL, 0);
+        sync_destroy(&game_sync->view_update_sem);
+        sync_destroy(&game_sync->view_done_sem);
+        sync_init(&game_sync->view_update_sem, 0);
+        sync_init(&game_sync->view_done_sem, 0);
+    }
+    
+    // Leftover grants and moves of the finished game must not leak into the next one
+    for (int i = 0; i < player_count; i++) {
+        while (sync_trywait(&game_sync->player_move_sem[i]) == 0) {
+        }
+        drain_pipe(players[i].pipe_fd[READ_END]);
+    }
+    reset_game(seed + pool.played);
+    
+    sprintf(width_str, "%d", game_state->width);
+    sprintf(height_str, "%d", game_state->height);
+    for (int i = 0; i < player_count; i++) {
+        if (exited[i]) {
+            close(players[i].pipe_fd[READ_END]);
+            start_player(i, width_str, height_str);
+        }
+    }
+    if (view.binary_path != NULL) {
+        start_view(width_str, height_str);
+    }
+    pool.respawned += gone;
+    wait_ready(gone + (view.binary_path != NULL ? 1 : 0), READY_TIMEOUT_MS);
+    
+    // First move of the new game; parked players take it as their wake-up
+    for (int i = 0; i < player_count; i++) {
+        sync_post(&game_sync->player_move_sem[i]);
+    }
+    return true;
+}
+
+void report_pool(void) {
+    if (master_options.games <= 1) {
+        return;
+    }
+    
+    double elapsed_s = (game_metrics->end_ns - game_metrics->start_ns) / 1e9;
+    printf("pool: games=%d elapsed_s=%.3f games_per_s=%.1f respawned=%d\n", pool.played,
+           elapsed_s, elapsed_s > 0 ? pool.played / elapsed_s : 0.0, pool.respawned);
+    printf("pool wins:");
+    for (int i = 0; i < player_count; i++) {
+        printf(" %s=%d", game_state->players[i].name, pool.wins[i]);
+    }
+    printf("\n");
+}
+
+void init_padded_board(void) {
+    padded_board_free(&padded_board);
+    if (padded_board_init(&padded_board, game_state->width, game_state->height,
+                          PADDED_BORDER, movement) != 0) {
+        perror("padded board");
+        exit(EXIT_FAILURE);
+    }
+    padded_board_load(&padded_board, game_state->board);
+    kernels = kernels_select(&padded_board);
+}
+
+void init_connectivity(void) {
+    connectivity_free(&connectivity);
+    if (connectivity_init(&connectivity, &padded_board) != 0) {
+        perror("connectivity");
+        exit(EXIT_FAILURE);
+    }
+}
+
+void report_pacing(void) {
+    // A game's first frame only starts its clock, so the rate is over the intervals after it
+    const PacingTotals* t = &pacing_totals;
+    double span_s = t->span_ns / 1e9;
+    double achieved = span_s > 0 ? t->intervals / span_s : 0.0;
+    
+    if (master_options.pacing == PACING_RATE) {
+        printf("pacing: mode=rate target=%.1f/s achieved=%.1f/s frames=%llu err_avg_us=%.1f "
+               "err_max_us=%.1f overruns=%llu\n", master_options.pace_rate, achieved, t->frames,
+               t->frames > 0 ? t->error_ns / 1e3 / t->frames : 0.0,
+               t->max_error_ns / 1e3, t->overruns);
+    } else {
+        printf("pacing: mode=%s achieved=%.1f/s frames=%llu\n",
+               master_options.pacing == PACING_OFF ? "off" : "delay", achieved, t->frames);
+    }
+}
+
+void merge_trace(void) {
+    pid_t pids[MAX_PLAYERS + 1];
+    int count = 0;
+    
+    for (int i = 0; i < player_count; i++) {
+        if (!players[i].remote && players[i].pid > 0) {
+            pids[count++] = players[i].pid;
+        }
+    }
+    if (view.binary_path != NULL && view.pid > 0) {
+        pids[count++] = view.pid;
+    }
+    trace_merge(pids, count);
+}
+
+void report_regions(void) {
+    printf("\nReachable regions (%s%lu relabels, %lu split refills):\n",
+           master_options.games > 1 ? "last game, " : "", connectivity.relabels,
+           connectivity.split_fills);
+    for (int i = 0; i < player_count; i++) {
+        int cells;
+        long reward;
+        connectivity_reach(&connectivity, game_state->players[i].x, game_state->players[i].y,
+                           &cells, &reward);
+        printf("%s: %d free cells, %ld reward left\n", game_state->players[i].name, cells, reward);
+    }
+}
+
+void report_board_stats(void) {
+    BoardStats stats;
+    board_stats(game_state->board, (size_t)game_state->width * game_state->height, &stats);
     
+    printf("\nBoard totals%s:\n", master_options.games > 1 ? " (last game)" : "");
+    for (int i = 0; i < player_count; i++) {
+        printf("%s: %d cells owned\n", game_state->players[i].name, stats.owned[i]);
+    }
+    printf("free: %d cells, %ld reward\n", stats.free_cells, stats.free_reward);
+    printf("rewards left:");
+    for (int reward = 1; reward <= STATS_MAX_REWARD; reward++) {
+        printf(" %d:%d", reward, stats.reward_hist[reward]);
+    }
+    printf("\n");
+}
+
+bool process_movement(int player_idx, unsigned char direction) {
     if (direction > 7) {
         // Invalid direction
         game_state->players[player_idx].invalid_moves++;
         return false;
     }
     
-    int width = game_state->width;
-    int height = game_state->height;
     int x = game_state->players[player_idx].x;
     int y = game_state->players[player_idx].y;
-    int new_x = x + movement[direction][0];
-    int new_y = y + movement[direction][1];
     
-    // Check if new position is valid
-    if (new_x < 0 || new_x >= width || new_y < 0 || new_y >= height) {
-        // Out of bounds
+    // Mark the cell as captured by the player, in the mirror and in shared memory.
+    // Out-of-bounds moves land on a sentinel, which reads as captured
+    int cell_value = kernels->claim(&padded_board, game_state->board, x, y, direction,
+                                    -(player_idx ));
+    if (cell_value <= 0) {
         game_state->players[player_idx].invalid_moves++;
-    } else {
-        int cell_value = game_state->board[new_y * width + new_x];
-        if (cell_value <= 0) {
-            // Cell already captured
-            game_state->players[player_idx].invalid_moves++;
-        } else {
-            // Valid move
-            game_state->players[player_idx].valid_moves++;
-            game_state->players[player_idx].score += cell_value;
-            game_state->players[player_idx].x = new_x;
-            game_state->players[player_idx].y = new_y;
-            
-            // Mark the cell as captured by the player
-            game_state->board[new_y * width + new_x] = -(player_idx );
-            
-            result = true;
-        }
+        return false;
     }
     
-    return result;
+    // Valid move
+    game_state->players[player_idx].valid_moves++;
+    game_state->players[player_idx].score += cell_value;
+    game_state->players[player_idx].x = x + movement[direction][0];
+    game_state->players[player_idx].y = y + movement[direction][1];
+    
+    return true;
 }
 
 bool can_player_move(int player_idx) {
-    int width = game_state->width;
-    int height = game_state->height;
-    int x = game_state->players[player_idx].x;
-    int y = game_state->players[player_idx].y;
+    // Sentinels are never free, so no bounds checks are needed
+    return kernels->can_move(&padded_board, game_state->players[player_idx].x,
+                             game_state->players[player_idx].y);
+}
+
+#ifdef USE_FUTEX_SYNC
+static void print_sync_line(const char* label, SyncSem* s) {
+    SyncStats stats;
+    sync_stats(s, &stats);
+    printf("%-20s spins: %llu, parks: %llu, avg wake: %llu ns, max wake: %llu ns\n",
+           label, stats.spins, stats.parks,
+           stats.parks > 0 ? stats.wake_latency_ns / stats.parks : 0ULL,
+           stats.max_wake_latency_ns);
+}
+#endif
+
+void report_sync_stats(void) {
+#ifdef USE_FUTEX_SYNC
+    char label[32];
     
-    // Check all 8 directions
-    for (int dir = 0; dir < 8; dir++) {
-        int new_x = x + movement[dir][0];
-        int new_y = y + movement[dir][1];
-        
-        if (new_x >= 0 && new_x < width && new_y >= 0 && new_y < height) {
-            int cell_value = game_state->board[new_y * width + new_x];
-            if (cell_value > 0) {
-                return true; // Player can move
-            }
-        }
+    printf("\nSynchronization stats:\n");
+    print_sync_line("view_update_sem", &game_sync->view_update_sem);
+    print_sync_line("view_done_sem", &game_sync->view_done_sem);
+    print_sync_line("game_state_mutex", &game_sync->game_state_mutex);
+    print_sync_line("reader_count_mutex", &game_sync->reader_count_mutex);
+    for (int i = 0; i < player_count; i++) {
+        snprintf(label, sizeof(label), "player_move_sem[%d]", i);
+        print_sync_line(label, &game_sync->player_move_sem[i]);
     }
-    
-    return false; // Player cannot move
+#endif
 }
 
 void cleanup(void) {
-    // Close all pipes
+    if (master_options.checkpoint_path != NULL) {
+        checkpoint_finish(&checkpointer);
+    }
+    connectivity_free(&connectivity);
+    padded_board_free(&padded_board);
+    
+    // Close all pipes and remote connections
     for (int i = 0; i < player_count; i++) {
         if (players[i].pipe_fd[READ_END] > 0) {
             close(players[i].pipe_fd[READ_END]);
             players[i].pipe_fd[READ_END] = -1;
         }
     }
+    close_remote_players();
     
     // Signal all players one last time to prevent deadlocks
     if (game_sync != NULL) {
         for (int i = 0; i < player_count; i++) {
-            sem_post(&game_sync->player_move_sem[i]);
+            sync_post(&game_sync->player_move_sem[i]);
         }
     }
     
     // Destroy semaphores
     if (game_sync != NULL) {
-        sem_destroy(&game_sync->view_update_sem);
-        sem_destroy(&game_sync->view_done_sem);
-        sem_destroy(&game_sync->master_access_mutex);
-        sem_destroy(&game_sync->game_state_mutex);
-        sem_destroy(&game_sync->reader_count_mutex);
+        sync_destroy(&game_sync->view_update_sem);
+        sync_destroy(&game_sync->view_done_sem);
+        sync_destroy(&game_sync->master_access_mutex);
+        sync_destroy(&game_sync->game_state_mutex);
+        sync_destroy(&game_sync->reader_count_mutex);
+        sync_destroy(&game_sync->ready_sem);
         
         for (int i = 0; i < player_count; i++) {
-            sem_destroy(&game_sync->player_move_sem[i]);
+            sync_destroy(&game_sync->player_move_sem[i]);
         }
     }
     
     // Unmap and unlink shared memory
+    if (game_metrics != NULL) {
+        metrics_destroy(game_metrics);
+        game_metrics = NULL;
+    }
+    
+    if (game_hints != NULL) {
+        hints_destroy(game_hints);
+        game_hints = NULL;
+    }
+    
     if (game_state != NULL) {
         close_shared_memory(game_state, NAME_BOARD, game_state_size);
         game_state = NULL;
@@ -554,38 +1646,16 @@ void cleanup(void) {
         close_shared_memory(game_sync, NAME_SYNC, sizeof(GameSync));
         game_sync = NULL;
     }
+    
+    log_shutdown();
 }
 
 void sig_handler(int signo) {
-    printf("Received signal %d. Cleaning up and exiting...\n", signo);
-    
-    if (game_state != NULL) {
-        game_state->game_over = true;
-    }
-    
-    if (game_sync != NULL) {
-        for (int i = 0; i < player_count; i++) {
-            sem_post(&game_sync->player_move_sem[i]);
-        }
-    }
-    
-    if (game_sync != NULL && view.binary_path != NULL) {
-        sem_post(&game_sync->view_update_sem);
+    // Only async-signal-safe work here; the rules thread sees the flag and ends the game
+    if (stop_signal != 0) {
+        signal(signo, SIG_DFL); // A second signal ends a shutdown that got stuck
+        raise(signo);
+        return;
     }
-    
-    usleep(100000); // 100ms
-    
-    if (view.binary_path != NULL && view.pid > 0) {
-        kill(view.pid, SIGTERM);
-    }
-    
-    for (int i = 0; i < player_count; i++) {
-        if (players[i].pid > 0) {
-            kill(players[i].pid, SIGTERM);
-        }
-    }
-    
-    usleep(100000); // 100ms
-    cleanup();
-    exit(EXIT_SUCCESS);
+    stop_signal = signo;
 }
\ No newline at end of file
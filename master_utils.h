@@ -10,13 +10,32 @@
 #include <sys/wait.h>
 #include <sys/select.h>
 #include <sys/time.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <poll.h>
 #include <fcntl.h>
 #include <errno.h>
 #include <limits.h>
 #include <getopt.h>
 #include <stdbool.h>
 #include <math.h>
+#include <spawn.h>
+#include <pthread.h>
 #include "sharedMem.h"
+#include "metrics.h"
+#include "hints.h"
+#include "board.h"
+#include "kernels.h"
+#include "analytics.h"
+#include "connectivity.h"
+#include "checkpoint.h"
+#include "log.h"
+#include "intake.h"
+#include "placement.h"
+#include "rt.h"
+#include "remote.h"
+#include "trace.h"
+#include "pool.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -31,17 +50,26 @@
 #define WRITE_END 1
 #define TO_MILI_SEC 1000
 #define PLAYER_NAME_MAX_LENGTH 16
+#define READY_TIMEOUT_MS 1000
+#define PADDED_BORDER 1 // The master only probes direct neighbours
+#define CHECKPOINT_INTERVAL_MS 1000
+
+extern char** environ;
 
 // Movement directions
 extern const int movement[8][2];
 
 /* This struct is used to store the process information
  * for each player, including pipes for communication.
+ * Remote players are not spawned: they attach through the master's socket,
+ * and pid is then the process hosting them.
  */
 typedef struct {
     pid_t pid;
     int pipe_fd[2]; // pipe for receiving movement requests
     char* binary_path;
+    bool remote;    // Slot given as REMOTE_SLOT on the command line
+    int socket_fd;  // Remote players: connection carrying their moves, -1 until attached
 } PlayerProcess;
 
 /* This struct is used to store the process information
@@ -52,13 +80,43 @@ typedef struct {
     char* binary_path;
 } ViewProcess;
 
+/* How valid moves are spaced out (-d, -P) */
+typedef enum {
+    PACING_DELAY,      // Sleep -d ms after each valid move's frame (default)
+    PACING_RATE,       // -P rate: valid moves on a fixed grid of absolute deadlines
+    PACING_OFF         // -P off: never sleep, whatever -d says
+} PacingMode;
+
+/* Optional master features selected on the command line.
+ */
+typedef struct {
+    bool fast_forward; // -f: end the game once regions are separate and the winner is settled
+    const char* checkpoint_path; // -c: checkpoint the game to this file periodically
+    const char* restore_path;    // -r: resume the game saved in this checkpoint
+    IntakeBackend intake;        // -i: how moves are read (auto, epoll or io_uring)
+    Placement placement;         // -a, -n: CPU sets and NUMA node
+    const char* socket_path;     // -u: where remote players connect
+    PacingMode pacing;           // -P: delay, fixed rate or none
+    double pace_rate;            // -P: target valid moves per second
+    int games;                   // -g: games played by the same (pooled) players
+} MasterOptions;
+
 // External declarations for global variables (defined in master.c)
 extern GameState* game_state;
 extern GameSync* game_sync;
+extern GameMetrics* game_metrics;
+extern HintTable* game_hints;
 extern PlayerProcess players[MAX_PLAYERS];
 extern ViewProcess view;
 extern int player_count;
 extern size_t game_state_size;
+extern PaddedBoard padded_board;
+extern const KernelSet* kernels;
+extern Connectivity connectivity;
+extern MasterOptions master_options;
+extern Checkpointer checkpointer;
+extern CheckpointInfo resume_info;
+extern volatile sig_atomic_t stop_signal;  // Set by sig_handler(); the rules thread shuts down
 
 // Function prototypes
 
@@ -74,10 +132,18 @@ extern size_t game_state_size;
  * @param view_path Pointer to store the path to the view binary.
  * @param player_paths Pointer to array of player binary paths.
  * @param player_count Pointer to store the number of players.
+ * @param options Pointer to store the optional master features.
  */
 void parse_args(int argc, char* argv[], int* width, int* height, int* delay, 
                 int* timeout, unsigned int* seed, char** view_path, 
-                char*** player_paths, int* player_count);
+                char*** player_paths, int* player_count, MasterOptions* options);
+
+/**
+ * @brief Fill the board with random rewards (1-9).
+ * @param state Game state whose width and height are already set.
+ * @param seed The random seed for board generation.
+ */
+void generate_board(GameState* state, unsigned int seed);
 
 /**
  * @brief Initialize the game state with board and player information.
@@ -88,6 +154,68 @@ void parse_args(int argc, char* argv[], int* width, int* height, int* delay,
  */
 void init_game_state(int width, int height, int player_count, unsigned int seed);
 
+/**
+ * @brief Create the game state from a checkpoint instead of a new board.
+ *
+ * Players keep their positions, scores and blocked flags; resume_info gets
+ * the saved round-robin position and timers for game_loop().
+ * @param path Checkpoint file.
+ * @param player_count Number of players given with -p; must match the checkpoint.
+ */
+void restore_game_state(const char* path, int player_count);
+
+/**
+ * @brief Prepare periodic checkpoints if -c was given.
+ */
+void init_checkpoints(void);
+
+/**
+ * @brief Open the socket remote players connect to, if any slot is remote.
+ *
+ * Call before start_players_and_view() so they can connect while the
+ * spawned players start.
+ */
+void listen_for_remote_players(void);
+
+/**
+ * @brief Accept remote players until every remote slot is taken.
+ *
+ * Each connection asks for a number of slots and gets the next free ones.
+ * Slots still free when the time runs out start the game blocked.
+ * @param timeout_ms Maximum time to wait, in milliseconds.
+ */
+void attach_remote_players(int timeout_ms);
+
+/**
+ * @brief Resolve and apply CPU and NUMA placement.
+ *
+ * Pins the master's threads and binds the shared memory segments to the
+ * chosen node; children are pinned as they are spawned. Call after the
+ * segments exist and before start_players_and_view().
+ */
+void apply_placement(void);
+
+/**
+ * @brief Enter the low-jitter mode requested with -R (or RT_ENV).
+ *
+ * Prefaults the shared memory segments, locks memory and, in fifo mode,
+ * moves the master to SCHED_FIFO; the threads started by game_loop()
+ * inherit it. Call after apply_placement().
+ */
+void enter_rt_mode(void);
+
+/**
+ * @brief Print the CPU migrations of the master and of every child.
+ *
+ * Call before the children are reaped.
+ */
+void report_migrations(void);
+
+/**
+ * @brief Print how many checkpoints were written and the longest pause they caused.
+ */
+void report_checkpoints(void);
+
 /**
  * @brief Initialize synchronization primitives for the game.
  * @param player_count The number of players to create semaphores for.
@@ -99,6 +227,51 @@ void init_game_sync(int player_count);
  */
 void place_players_on_board(void);
 
+/**
+ * @brief Build the master's private sentinel-padded mirror of the board.
+ *
+ * process_movement() and can_player_move() probe the mirror and write
+ * captures through to shared memory, using the kernels picked here for the
+ * board size. Call after the board is final.
+ */
+void init_padded_board(void);
+
+/**
+ * @brief Label the free regions of the board for connectivity tracking.
+ *
+ * Call after init_padded_board(); the tracker follows the padded mirror.
+ */
+void init_connectivity(void);
+
+/**
+ * @brief Create the hints segment and publish every player's first hint.
+ *
+ * Call after init_padded_board(); hints are read from the padded mirror.
+ */
+void init_hints(void);
+
+/**
+ * @brief Print the achieved rate of valid moves and, with -P rate, the pacing error.
+ */
+void report_pacing(void);
+
+/**
+ * @brief Merge the trace dumps of the view and the local players into the -T file.
+ *
+ * Call after the children have been waited for; no-op without -T.
+ */
+void merge_trace(void);
+
+/**
+ * @brief Print the free cells and reward each player can still reach.
+ */
+void report_regions(void);
+
+/**
+ * @brief Print the cells each player owns and the free cells and rewards left on the board.
+ */
+void report_board_stats(void);
+
 /**
  * @brief Start all player processes and the view process.
  * @param width The width of the game board.
@@ -106,8 +279,40 @@ void place_players_on_board(void);
  */
 void start_players_and_view(int width, int height);
 
+/**
+ * @brief Record the finished game and, with -g, set up the next one.
+ *
+ * Waits for the players to park (see pool.h), spawns again the ones that
+ * exited and the view, resets the board on the same shared memory and
+ * grants everyone their first move.
+ * @param seed Seed of the first game; game k uses seed + k.
+ * @return true if another game is ready to play, false after the last one.
+ */
+bool next_pooled_game(unsigned int seed);
+
+/**
+ * @brief Let the players and the view go once no game follows, and terminate stragglers.
+ */
+void release_participants(void);
+
+/**
+ * @brief Print the games played per second and the wins of each player (-g only).
+ */
+void report_pool(void);
+
+/**
+ * @brief Wait until every spawned child has signaled readiness, or the timeout expires.
+ * @param timeout_ms Maximum time to wait in milliseconds.
+ */
+void wait_for_participants(int timeout_ms);
+
 /**
  * @brief Main game loop that processes player movements and manages game flow.
+ *
+ * Runs the rules on the calling thread; an I/O thread (see intake.h) reads
+ * the pipes and a presenter thread handles the view and the delay. At game
+ * over it wakes the players and shows the final frame; release_participants()
+ * ends them.
  * @param delay The delay between moves in milliseconds.
  * @param timeout The timeout for player responses in seconds.
  */
@@ -128,6 +333,11 @@ bool process_movement(int player_idx, unsigned char direction);
  */
 bool can_player_move(int player_idx);
 
+/**
+ * @brief Print spin/park/wake-latency counters of the futex backend (no-op with sem_t).
+ */
+void report_sync_stats(void);
+
 /**
  * @brief Clean up resources including shared memory and semaphores.
  */
@@ -135,6 +345,9 @@ void cleanup(void);
 
 /**
  * @brief Signal handler for graceful shutdown on SIGINT/SIGTERM.
+ *
+ * Only records the signal: the game loop logs it, ends the game and the
+ * usual teardown runs on the main thread. A second signal kills the master.
  * @param signo The signal number received.
  */
 void sig_handler(int signo);
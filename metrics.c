@@ -0,0 +1,125 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "metrics.h"
+#include "sharedMem.h"
+
+GameMetrics* metrics_create(int player_count) {
+    GameMetrics* metrics = (GameMetrics*)create_shared_memory(NAME_METRICS, sizeof(GameMetrics));
+    
+    memset(metrics, 0, sizeof(GameMetrics));
+    metrics->player_count = player_count;
+    metrics->start_ns = metrics_now_ns();
+    __atomic_store_n(&metrics->magic, METRICS_MAGIC, __ATOMIC_RELEASE);
+    
+    return metrics;
+}
+
+void metrics_destroy(GameMetrics* metrics) {
+    if (metrics != NULL) {
+        __atomic_store_n(&metrics->game_over, true, __ATOMIC_RELAXED);
+        close_shared_memory(metrics, NAME_METRICS, sizeof(GameMetrics));
+    }
+}
+
+const GameMetrics* metrics_attach(void) {
+    int fd = shm_open(NAME_METRICS, O_RDONLY, 0666);
+    if (fd == -1) {
+        return NULL;
+    }
+    
+    void* ptr = mmap(NULL, sizeof(GameMetrics), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+    
+    const GameMetrics* metrics = (const GameMetrics*)ptr;
+    if (__atomic_load_n(&metrics->magic, __ATOMIC_ACQUIRE) != METRICS_MAGIC) {
+        munmap(ptr, sizeof(GameMetrics));
+        return NULL;
+    }
+    return metrics;
+}
+
+int metrics_latency_bucket(unsigned long long latency_ns) {
+    unsigned long long us = latency_ns / 1000;
+    int bucket = 0;
+    
+    while (us > 0 && bucket < METRICS_LATENCY_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void metrics_record_move(GameMetrics* metrics, int player_idx, bool valid,
+                         unsigned long long latency_ns, unsigned long long queue_depth) {
+    PlayerMetrics* player = &metrics->players[player_idx];
+    
+    metrics_add(&metrics->global.moves, 1);
+    metrics_add(&player->moves, 1);
+    if (!valid) {
+        metrics_add(&metrics->global.invalid_moves, 1);
+        metrics_add(&player->invalid_moves, 1);
+    }
+    
+    metrics_add(&player->latency[metrics_latency_bucket(latency_ns)], 1);
+    
+    __atomic_store_n(&player->queue_depth, queue_depth, __ATOMIC_RELAXED);
+    if (queue_depth > metrics_load(&player->max_queue_depth)) {
+        __atomic_store_n(&player->max_queue_depth, queue_depth, __ATOMIC_RELAXED);
+    }
+}
+
+unsigned long long metrics_latency_percentile(const GameMetrics* metrics, double percentile) {
+    unsigned long long buckets[METRICS_LATENCY_BUCKETS] = {0};
+    unsigned long long total = 0;
+    
+    for (unsigned int i = 0; i < metrics->player_count && i < METRICS_MAX_PLAYERS; i++) {
+        for (int b = 0; b < METRICS_LATENCY_BUCKETS; b++) {
+            unsigned long long count = metrics_load(&metrics->players[i].latency[b]);
+            buckets[b] += count;
+            total += count;
+        }
+    }
+    if (total == 0) {
+        return 0;
+    }
+    
+    unsigned long long rank = (unsigned long long)(total * percentile / 100.0);
+    unsigned long long seen = 0;
+    for (int b = 0; b < METRICS_LATENCY_BUCKETS; b++) {
+        seen += buckets[b];
+        if (seen >= rank && seen > 0) {
+            return 1ULL << b;
+        }
+    }
+    return 1ULL << (METRICS_LATENCY_BUCKETS - 1);
+}
+
+void metrics_print_summary(const GameMetrics* metrics, FILE* out) {
+    unsigned long long end_ns = metrics->end_ns != 0 ? metrics->end_ns : metrics_now_ns();
+    double elapsed_s = (end_ns - metrics->start_ns) / 1e9;
+    unsigned long long moves = metrics_load(&metrics->global.moves);
+    unsigned long long locks = metrics_load(&metrics->global.lock_acquisitions);
+    unsigned long long frames = metrics_load(&metrics->global.view_frames);
+    
+    fprintf(out, "metrics: moves=%llu invalid=%llu elapsed_s=%.3f moves_per_s=%.1f "
+            "lock_wait_avg_us=%.2f view_wait_avg_us=%.2f latency_p50_us=%llu latency_p99_us=%llu "
+            "iteration_avg_us=%.2f iteration_max_us=%.2f sleep_late_max_us=%.2f\n",
+            moves, metrics_load(&metrics->global.invalid_moves), elapsed_s,
+            elapsed_s > 0 ? moves / elapsed_s : 0.0,
+            locks > 0 ? metrics_load(&metrics->global.lock_wait_ns) / 1e3 / locks : 0.0,
+            frames > 0 ? metrics_load(&metrics->global.view_wait_ns) / 1e3 / frames : 0.0,
+            metrics_latency_percentile(metrics, 50.0),
+            metrics_latency_percentile(metrics, 99.0),
+            moves > 0 ? metrics_load(&metrics->global.iteration_ns) / 1e3 / moves : 0.0,
+            metrics_load(&metrics->global.max_iteration_ns) / 1e3,
+            metrics_load(&metrics->global.max_sleep_late_ns) / 1e3);
+}
@@ -0,0 +1,131 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdio.h>
+#include <time.h>
+#include <stdbool.h>
+
+/* Shared memory segment with live counters published by the master */
+#define NAME_METRICS "/game_metrics"
+
+#define METRICS_MAGIC 0x43484d50u     // "CHMP"
+#define METRICS_LATENCY_BUCKETS 16    // Bucket b holds latencies below 2^b microseconds
+#define METRICS_MAX_PLAYERS 9
+
+/* Per-player counters. Each player owns a cache line (or more) so the master
+ * updating one player never invalidates the line a monitor is reading for another.
+ */
+typedef struct {
+    unsigned long long moves;                 // Movement requests processed
+    unsigned long long invalid_moves;         // Rejected movement requests
+    unsigned long long queue_depth;           // Bytes left in the pipe after the last read
+    unsigned long long max_queue_depth;       // Highest queue_depth seen
+    unsigned long long latency[METRICS_LATENCY_BUCKETS]; // Move grant to move read
+} __attribute__((aligned(64))) PlayerMetrics;
+
+/* Global counters, kept apart from the read-mostly header. Every field has a
+ * single writer: the presenter owns view_wait_ns, view_frames and
+ * max_sleep_late_ns, and the rules thread owns the rest.
+ */
+typedef struct {
+    unsigned long long moves;                 // Movement requests processed
+    unsigned long long invalid_moves;         // Rejected movement requests
+    unsigned long long lock_wait_ns;          // Time spent acquiring the state mutex
+    unsigned long long lock_acquisitions;     // Number of state mutex acquisitions
+    unsigned long long view_wait_ns;          // Time spent in the view handshake
+    unsigned long long view_frames;           // Number of view handshakes
+    unsigned long long iteration_ns;          // Time the rules thread spent handling moves
+    unsigned long long max_iteration_ns;      // Slowest single move, dequeue to player grant
+    unsigned long long max_sleep_late_ns;     // Worst oversleep of the -d delay
+} __attribute__((aligned(64))) GlobalMetrics;
+
+/* Layout of the /game_metrics segment */
+typedef struct {
+    unsigned int magic;                       // METRICS_MAGIC once initialized
+    unsigned int player_count;                // Number of players
+    unsigned long long start_ns;              // CLOCK_MONOTONIC time the game started
+    unsigned long long end_ns;                // CLOCK_MONOTONIC time the game ended (0 while running)
+    bool game_over;                           // Set when the master leaves the game loop
+    GlobalMetrics global;
+    PlayerMetrics players[METRICS_MAX_PLAYERS];
+} __attribute__((aligned(64))) GameMetrics;
+
+/* Monotonic clock shared by every process on the host */
+static inline unsigned long long metrics_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/* Single-writer counter update; readers never take a lock. A relaxed load and
+ * store are enough and avoid a locked read-modify-write on the hot path. A
+ * counter with several writers would need __atomic_fetch_add instead.
+ */
+static inline void metrics_add(unsigned long long* counter, unsigned long long value) {
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value, __ATOMIC_RELAXED);
+}
+
+/* Single-writer maximum */
+static inline void metrics_max(unsigned long long* counter, unsigned long long value) {
+    if (value > __atomic_load_n(counter, __ATOMIC_RELAXED)) {
+        __atomic_store_n(counter, value, __ATOMIC_RELAXED);
+    }
+}
+
+static inline unsigned long long metrics_load(const unsigned long long* counter) {
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Create and map the metrics segment.
+ * @param player_count Number of players in the game.
+ * @return Pointer to the mapped metrics.
+ */
+GameMetrics* metrics_create(int player_count);
+
+/**
+ * @brief Unmap and unlink the metrics segment.
+ * @param metrics Pointer returned by metrics_create().
+ */
+void metrics_destroy(GameMetrics* metrics);
+
+/**
+ * @brief Map an existing metrics segment read-only.
+ * @return Pointer to the mapped metrics, or NULL if no game is publishing them.
+ */
+const GameMetrics* metrics_attach(void);
+
+/**
+ * @brief Record one processed movement request.
+ * @param metrics Pointer to the metrics segment.
+ * @param player_idx Player that sent the request.
+ * @param valid Whether the move was accepted.
+ * @param latency_ns Time between granting the move and reading it.
+ * @param queue_depth Bytes still pending in the player's pipe.
+ */
+void metrics_record_move(GameMetrics* metrics, int player_idx, bool valid,
+                         unsigned long long latency_ns, unsigned long long queue_depth);
+
+/**
+ * @brief Map a latency to its histogram bucket.
+ * @param latency_ns Latency in nanoseconds.
+ * @return Bucket index in [0, METRICS_LATENCY_BUCKETS).
+ */
+int metrics_latency_bucket(unsigned long long latency_ns);
+
+/**
+ * @brief Latency percentile over every player's histogram.
+ * @param metrics Pointer to the metrics segment.
+ * @param percentile Percentile in (0, 100].
+ * @return Upper bound of the bucket holding the percentile, in microseconds.
+ */
+unsigned long long metrics_latency_percentile(const GameMetrics* metrics, double percentile);
+
+/**
+ * @brief Print a one-line machine-readable summary of the game's metrics.
+ * @param metrics Pointer to the metrics segment.
+ * @param out Stream to print to.
+ */
+void metrics_print_summary(const GameMetrics* metrics, FILE* out);
+
+#endif // METRICS_H
@@ -0,0 +1,281 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h> // MPOL_* constants, from the kernel headers
+#include "placement.h"
+
+#define SYSFS_CPU "/sys/devices/system/cpu"
+#define SYSFS_NODE "/sys/devices/system/node"
+
+void placement_init(Placement* placement) {
+    memset(placement, 0, sizeof(*placement));
+    placement->auto_llc = true;
+    placement->numa_node = -1;
+}
+
+int placement_parse_cpulist(const char* list, cpu_set_t* set) {
+    const char* p = list;
+    
+    CPU_ZERO(set);
+    while (*p != '\0' && *p != '\n') {
+        char* end;
+        long first = strtol(p, &end, 10);
+        long last = first;
+        if (end == p || first < 0) {
+            return -1;
+        }
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            if (end == p + 1 || last < first) {
+                return -1;
+            }
+            p = end;
+        }
+        for (long cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET(cpu, set);
+        }
+        if (*p == ',') {
+            p++;
+        } else if (*p != '\0' && *p != '\n') {
+            return -1;
+        }
+    }
+    return CPU_COUNT(set) > 0 ? 0 : -1;
+}
+
+int placement_parse(Placement* placement, const char* spec) {
+    const char* cpus = strchr(spec, '=');
+    cpu_set_t set;
+    
+    if (strcmp(spec, "auto") == 0 || strcmp(spec, "none") == 0) {
+        placement->auto_llc = spec[0] == 'a';
+        return 0;
+    }
+    if (cpus == NULL || placement_parse_cpulist(cpus + 1, &set) != 0) {
+        return -1;
+    }
+    
+    size_t role = cpus - spec;
+    if (role == 6 && strncmp(spec, "master", role) == 0) {
+        placement->master = set;
+        placement->has_master = true;
+    } else if (role == 4 && strncmp(spec, "view", role) == 0) {
+        placement->view = set;
+        placement->has_view = true;
+    } else if (role == 7 && strncmp(spec, "players", role) == 0) {
+        for (int i = 0; i < PLACEMENT_MAX_PLAYERS; i++) {
+            placement->players[i] = set;
+            placement->has_player[i] = true;
+        }
+    } else if (role == 2 && spec[0] == 'p' && spec[1] >= '0' && spec[1] < '0' + PLACEMENT_MAX_PLAYERS) {
+        placement->players[spec[1] - '0'] = set;
+        placement->has_player[spec[1] - '0'] = true;
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+static int read_cpulist(const char* path, cpu_set_t* set) {
+    char line[1024];
+    FILE* f = fopen(path, "r");
+    
+    if (f == NULL) {
+        return -1;
+    }
+    char* ok = fgets(line, sizeof(line), f);
+    fclose(f);
+    return ok != NULL ? placement_parse_cpulist(line, set) : -1;
+}
+
+/* CPUs sharing the highest cache level with cpu */
+static int llc_domain(int cpu, cpu_set_t* set) {
+    char path[256];
+    int best_level = -1;
+    
+    for (int index = 0;; index++) {
+        int level;
+        FILE* f;
+        
+        snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/level", cpu, index);
+        f = fopen(path, "r");
+        if (f == NULL) {
+            break;
+        }
+        if (fscanf(f, "%d", &level) == 1 && level > best_level) {
+            snprintf(path, sizeof(path), SYSFS_CPU "/cpu%d/cache/index%d/shared_cpu_list", cpu, index);
+            if (read_cpulist(path, set) == 0) {
+                best_level = level;
+            }
+        }
+        fclose(f);
+    }
+    return best_level >= 0 ? 0 : -1;
+}
+
+void placement_resolve(Placement* placement, int player_count) {
+    cpu_set_t domain, online, node_cpus;
+    char path[128];
+    int cpu = sched_getcpu();
+    
+    if (!placement->auto_llc || read_cpulist(SYSFS_CPU "/online", &online) != 0) {
+        return;
+    }
+    
+    if (placement->numa_node >= 0) {
+        snprintf(path, sizeof(path), SYSFS_NODE "/node%d/cpulist", placement->numa_node);
+        if (read_cpulist(path, &node_cpus) == 0) {
+            // Start from the node's first CPU so the processes sit next to their memory
+            for (cpu = 0; cpu < CPU_SETSIZE && !CPU_ISSET(cpu, &node_cpus); cpu++) {
+            }
+        }
+    }
+    if (cpu < 0 || llc_domain(cpu, &domain) != 0) {
+        return;
+    }
+    CPU_AND(&domain, &domain, &online);
+    if (CPU_EQUAL(&domain, &online)) {
+        return; // One LLC for the whole machine: pinning would only restrict the scheduler
+    }
+    
+    if (!placement->has_master) {
+        placement->master = domain;
+        placement->has_master = true;
+    }
+    if (!placement->has_view) {
+        placement->view = domain;
+        placement->has_view = true;
+    }
+    for (int i = 0; i < player_count && i < PLACEMENT_MAX_PLAYERS; i++) {
+        if (!placement->has_player[i]) {
+            placement->players[i] = domain;
+            placement->has_player[i] = true;
+        }
+    }
+}
+
+int placement_apply_self(const Placement* placement) {
+    struct dirent* entry;
+    int result = 0;
+    
+    if (!placement->has_master) {
+        return 0;
+    }
+    
+    // Threads already running (the log drainer) are moved too; later ones inherit
+    DIR* tasks = opendir("/proc/self/task");
+    if (tasks == NULL) {
+        return sched_setaffinity(0, sizeof(cpu_set_t), &placement->master);
+    }
+    while ((entry = readdir(tasks)) != NULL) {
+        pid_t tid = (pid_t)atoi(entry->d_name);
+        if (tid > 0 && sched_setaffinity(tid, sizeof(cpu_set_t), &placement->master) != 0) {
+            result = -1;
+        }
+    }
+    closedir(tasks);
+    return result;
+}
+
+bool placement_spawn_begin(const cpu_set_t* cpus, cpu_set_t* saved) {
+    if (cpus == NULL || sched_getaffinity(0, sizeof(cpu_set_t), saved) != 0) {
+        return false;
+    }
+    return sched_setaffinity(0, sizeof(cpu_set_t), cpus) == 0;
+}
+
+void placement_spawn_end(const cpu_set_t* saved) {
+    sched_setaffinity(0, sizeof(cpu_set_t), saved);
+}
+
+int placement_bind_memory(void* addr, size_t length, int node) {
+    unsigned long nodemask[1];
+    
+    if (node < 0 || node >= (int)(8 * sizeof(nodemask))) {
+        errno = EINVAL;
+        return -1;
+    }
+    nodemask[0] = 1UL << node;
+    
+    // Raw syscall: mbind lives in libnuma, which the build does not need otherwise
+    return (int)syscall(__NR_mbind, addr, length, MPOL_BIND, nodemask,
+                        8 * sizeof(nodemask) + 1, MPOL_MF_MOVE | MPOL_MF_STRICT);
+}
+
+static long long task_migrations(const char* path) {
+    char line[256];
+    long long migrations = -1;
+    FILE* f = fopen(path, "r");
+    
+    if (f == NULL) {
+        return -1;
+    }
+    while (fgets(line, sizeof(line), f) != NULL) {
+        if (strncmp(line, "se.nr_migrations", 16) == 0) {
+            char* colon = strchr(line, ':');
+            if (colon != NULL) {
+                migrations = atoll(colon + 1);
+            }
+            break;
+        }
+    }
+    fclose(f);
+    return migrations;
+}
+
+long long placement_migrations(pid_t pid) {
+    char path[128];
+    struct dirent* entry;
+    long long total = -1;
+    
+    if (pid == 0) {
+        snprintf(path, sizeof(path), "/proc/self/task");
+    } else {
+        snprintf(path, sizeof(path), "/proc/%d/task", (int)pid);
+    }
+    DIR* tasks = opendir(path);
+    if (tasks == NULL) {
+        return -1;
+    }
+    while ((entry = readdir(tasks)) != NULL) {
+        char sched_path[PATH_MAX];
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(sched_path, sizeof(sched_path), "%s/%s/sched", path, entry->d_name);
+        long long migrations = task_migrations(sched_path);
+        if (migrations >= 0) {
+            total = (total < 0 ? 0 : total) + migrations;
+        }
+    }
+    closedir(tasks);
+    return total;
+}
+
+void placement_format_cpus(const cpu_set_t* set, char* out, size_t size) {
+    size_t used = 0;
+    
+    out[0] = '\0';
+    for (int cpu = 0; cpu < CPU_SETSIZE && used < size; cpu++) {
+        if (!CPU_ISSET(cpu, set)) {
+            continue;
+        }
+        int last = cpu;
+        while (last + 1 < CPU_SETSIZE && CPU_ISSET(last + 1, set)) {
+            last++;
+        }
+        used += snprintf(out + used, size - used, used > 0 ? ",%d" : "%d", cpu);
+        if (last > cpu && used < size) {
+            used += snprintf(out + used, size - used, "-%d", last);
+        }
+        cpu = last;
+    }
+}
\ No newline at end of file
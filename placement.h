@@ -0,0 +1,114 @@
+#ifndef PLACEMENT_H
+#define PLACEMENT_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <sched.h>
+#include <sys/types.h>
+
+#define PLACEMENT_MAX_PLAYERS 9
+
+/* Where the master, the view and each player may run, and which NUMA node
+ * backs the shared memory. Roles without a CPU set run wherever the
+ * scheduler puts them.
+ */
+typedef struct {
+    bool auto_llc;                            // Fill unset roles with one last-level cache domain
+    int numa_node;                            // Node for the shm segments, -1 for the kernel's choice
+    cpu_set_t master;
+    cpu_set_t view;
+    cpu_set_t players[PLACEMENT_MAX_PLAYERS];
+    bool has_master;
+    bool has_view;
+    bool has_player[PLACEMENT_MAX_PLAYERS];
+} Placement;
+
+/**
+ * @brief Set the defaults: topology-aware CPU sets, no memory binding.
+ * @param placement Placement to initialize.
+ */
+void placement_init(Placement* placement);
+
+/**
+ * @brief Apply one -a argument.
+ *
+ * "auto" and "none" turn the topology-aware default on or off.
+ * "role=cpus" pins a role, where role is master, view, players or pN
+ * (player N, from 0), and cpus is a list like 0-3,8.
+ * @param placement Placement to update.
+ * @param spec The argument.
+ * @return 0 on success, -1 if it could not be parsed.
+ */
+int placement_parse(Placement* placement, const char* spec);
+
+/**
+ * @brief Parse a kernel-style CPU list such as "0-3,8,10-11".
+ * @param list The list.
+ * @param set Output set.
+ * @return 0 on success, -1 if it is malformed or empty.
+ */
+int placement_parse_cpulist(const char* list, cpu_set_t* set);
+
+/**
+ * @brief Resolve the topology-aware default for the roles left unset.
+ *
+ * Everything goes to the last-level cache domain of the CPU the master runs
+ * on (or of the first CPU of the NUMA node, if one was chosen). Nothing is
+ * pinned when that domain already spans every online CPU.
+ * @param placement Placement to complete.
+ * @param player_count Number of players.
+ */
+void placement_resolve(Placement* placement, int player_count);
+
+/**
+ * @brief Pin every thread of the calling process to the master's CPU set.
+ * @param placement A resolved placement.
+ * @return 0 on success (or nothing to do), -1 with errno set on failure.
+ */
+int placement_apply_self(const Placement* placement);
+
+/**
+ * @brief Make the calling thread's children start on a CPU set.
+ *
+ * posix_spawn() has no affinity attribute, so the spawning thread takes the
+ * child's set for the duration of the spawn and placement_spawn_end() puts
+ * its own back. The child never runs outside its set.
+ * @param cpus The child's set, or NULL to leave it alone.
+ * @param saved Output: the calling thread's current set.
+ * @return true if the affinity was changed and must be restored.
+ */
+bool placement_spawn_begin(const cpu_set_t* cpus, cpu_set_t* saved);
+
+/**
+ * @brief Restore the spawning thread's CPU set.
+ * @param saved Set returned by placement_spawn_begin().
+ */
+void placement_spawn_end(const cpu_set_t* saved);
+
+/**
+ * @brief Bind a mapping's pages to a NUMA node, moving those already touched.
+ * @param addr Start of the mapping (page aligned).
+ * @param length Length of the mapping.
+ * @param node NUMA node.
+ * @return 0 on success, -1 with errno set on failure.
+ */
+int placement_bind_memory(void* addr, size_t length, int node);
+
+/**
+ * @brief CPU migrations of every thread of a process, from /proc/pid/task/.../sched.
+ *
+ * Works for exited children that have not been reaped yet.
+ * @param pid Process, or 0 for the calling process.
+ * @return Total migrations, or -1 if unavailable.
+ */
+long long placement_migrations(pid_t pid);
+
+/**
+ * @brief Print a CPU set as a list, e.g. "0-3,8".
+ * @param set The set.
+ * @param out Destination buffer.
+ * @param size Size of the buffer.
+ */
+void placement_format_cpus(const cpu_set_t* set, char* out, size_t size);
+
+#endif // PLACEMENT_H
\ No newline at end of file
@@ -0,0 +1,262 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include "sharedMem.h"
+#include "player_utils.h"
+#include "rt.h"
+
+// Synthetic load player. Its argv is fixed by the master (width height), so
+// the load pattern comes from the environment:
+//   FLOOD_PATTERN  valid | invalid | oob | pause | mixed   (default: valid)
+//   FLOOD_BURST    moves per burst for the ungated patterns (default: 64)
+//   FLOOD_PAUSE_MS pause between bursts for pause/mixed     (default: 10)
+
+#define DEFAULT_BURST 64
+#define MAX_BURST 4096
+#define DEFAULT_PAUSE_MS 10
+#define INVALID_DIRECTION_BASE 8   // Any direction > 7 is rejected by the master
+
+typedef enum {
+    PATTERN_VALID,      // Max-rate valid moves, one per grant, no reader lock
+    PATTERN_INVALID,    // Bursts of directions > 7, ignoring grants
+    PATTERN_OOB,        // Walks to an edge, then bursts of moves off the board, ignoring grants
+    PATTERN_PAUSE,      // Valid bursts separated by pauses
+    PATTERN_MIXED       // Rotates through all of the above
+} FloodPattern;
+
+GameState* game_state = NULL;
+GameSync* game_sync = NULL;
+size_t game_state_size = 0;
+int player_idx = -1;
+
+FloodPattern parse_pattern(const char* name);
+unsigned char valid_direction(void);
+int out_of_bounds_direction(void);
+unsigned char edge_direction(void);
+int send_moves(const unsigned char* moves, size_t count);
+void cleanup(void);
+void sig_handler(int signo);
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <width> <height>\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    
+    int width = atoi(argv[1]);
+    int height = atoi(argv[2]);
+    
+    signal(SIGINT, sig_handler);
+    signal(SIGTERM, sig_handler);
+    signal(SIGPIPE, SIG_IGN); // A closed pipe ends the flood through write() errors
+    
+    FloodPattern pattern = parse_pattern(getenv("FLOOD_PATTERN"));
+    int burst = getenv("FLOOD_BURST") ? atoi(getenv("FLOOD_BURST")) : DEFAULT_BURST;
+    int pause_ms = getenv("FLOOD_PAUSE_MS") ? atoi(getenv("FLOOD_PAUSE_MS")) : DEFAULT_PAUSE_MS;
+    if (burst < 1 || burst > MAX_BURST) {
+        burst = DEFAULT_BURST;
+    }
+    
+    game_state_size = sizeof(GameState) + width * height * sizeof(int);
+    game_state = (GameState*)open_shared_memory(NAME_BOARD, game_state_size, O_RDONLY);
+    game_sync = (GameSync*)open_shared_memory(NAME_SYNC, sizeof(GameSync), O_RDWR);
+    
+    pid_t pid = getpid();
+    for (int attempt = 0; attempt < 100 && player_idx < 0; attempt++) {
+        for (unsigned int i = 0; i < game_state->player_count; i++) {
+            if (game_state->players[i].pid == pid) {
+                player_idx = i;
+            }
+        }
+        if (player_idx < 0) {
+            usleep(1000);
+        }
+    }
+    if (player_idx < 0) {
+        fprintf(stderr, "player_flood: could not find player index for PID %d\n", pid);
+        cleanup();
+        exit(EXIT_FAILURE);
+    }
+    
+    // Low-jitter mode requested through the master's -R
+    if (rt_mode() != RT_OFF) {
+        rt_prefault(game_state, game_state_size);
+        rt_prefault(game_sync, sizeof(GameSync));
+        rt_enter(RT_PRIORITY_CHILD);
+    }
+    
+    signal_ready(game_sync);
+    
+    unsigned char moves[MAX_BURST];
+    unsigned long long round = 0;
+    
+    while (!game_state->game_over) {
+        FloodPattern current = pattern == PATTERN_MIXED ? (FloodPattern)(round % PATTERN_MIXED) : pattern;
+        int ok = 1;
+        
+        switch (current) {
+            case PATTERN_VALID:
+                sync_wait(&game_sync->player_move_sem[player_idx]);
+                moves[0] = valid_direction();
+                ok = send_moves(moves, 1);
+                break;
+            case PATTERN_INVALID:
+                for (int i = 0; i < burst; i++) {
+                    moves[i] = INVALID_DIRECTION_BASE + (i % (256 - INVALID_DIRECTION_BASE));
+                }
+                ok = send_moves(moves, burst);
+                break;
+            case PATTERN_OOB: {
+                int oob = out_of_bounds_direction();
+                if (oob < 0) {
+                    // Not on an edge yet: walk there one granted move at a time
+                    sync_wait(&game_sync->player_move_sem[player_idx]);
+                    moves[0] = edge_direction();
+                    ok = send_moves(moves, 1);
+                    break;
+                }
+                for (int i = 0; i < burst; i++) {
+                    moves[i] = (unsigned char)oob;
+                }
+                ok = send_moves(moves, burst);
+                break;
+            }
+            case PATTERN_PAUSE:
+                for (int i = 0; i < burst && ok && !game_state->game_over; i++) {
+                    sync_wait(&game_sync->player_move_sem[player_idx]);
+                    moves[0] = valid_direction();
+                    ok = send_moves(moves, 1);
+                }
+                usleep(pause_ms * 1000);
+                break;
+            default:
+                break;
+        }
+        
+        if (!ok) {
+            break;
+        }
+        round++;
+    }
+    
+    cleanup();
+    return 0;
+}
+
+FloodPattern parse_pattern(const char* name) {
+    if (name == NULL || strcmp(name, "valid") == 0) {
+        return PATTERN_VALID;
+    } else if (strcmp(name, "invalid") == 0) {
+        return PATTERN_INVALID;
+    } else if (strcmp(name, "oob") == 0) {
+        return PATTERN_OOB;
+    } else if (strcmp(name, "pause") == 0) {
+        return PATTERN_PAUSE;
+    } else if (strcmp(name, "mixed") == 0) {
+        return PATTERN_MIXED;
+    }
+    fprintf(stderr, "player_flood: unknown FLOOD_PATTERN '%s', using 'valid'\n", name);
+    return PATTERN_VALID;
+}
+
+unsigned char valid_direction(void) {
+    // Deliberately lock-free: a stale read only costs an invalid move
+    int width = game_state->width;
+    int height = game_state->height;
+    int x = game_state->players[player_idx].x;
+    int y = game_state->players[player_idx].y;
+    
+    for (unsigned char dir = 0; dir < 8; dir++) {
+        int nx = x + vector[dir][0];
+        int ny = y + vector[dir][1];
+        if (nx >= 0 && nx < width && ny >= 0 && ny < height && game_state->board[ny * width + nx] > 0) {
+            return dir;
+        }
+    }
+    return 0;
+}
+
+int out_of_bounds_direction(void) {
+    // A direction that leaves the board from the current cell, or -1 away from the edges
+    int x = game_state->players[player_idx].x;
+    int y = game_state->players[player_idx].y;
+    
+    for (int dir = 0; dir < 8; dir++) {
+        int nx = x + vector[dir][0];
+        int ny = y + vector[dir][1];
+        if (nx < 0 || nx >= game_state->width || ny < 0 || ny >= game_state->height) {
+            return dir;
+        }
+    }
+    return -1;
+}
+
+unsigned char edge_direction(void) {
+    // Step towards the nearest edge, or any free cell when that one is taken
+    int x = game_state->players[player_idx].x;
+    int y = game_state->players[player_idx].y;
+    int to_right = game_state->width - 1 - x;
+    int to_bottom = game_state->height - 1 - y;
+    int best = y;
+    unsigned char dir = 0;  // Up
+    
+    if (to_right < best) {
+        best = to_right;
+        dir = 2;            // Right
+    }
+    if (to_bottom < best) {
+        best = to_bottom;
+        dir = 4;            // Down
+    }
+    if (x < best) {
+        dir = 6;            // Left
+    }
+    
+    int nx = x + vector[dir][0];
+    int ny = y + vector[dir][1];
+    if (game_state->board[ny * game_state->width + nx] > 0) {
+        return dir;
+    }
+    return valid_direction();
+}
+
+int send_moves(const unsigned char* moves, size_t count) {
+    size_t sent = 0;
+    while (sent < count) {
+        ssize_t n = write(STDOUT_FILENO, moves + sent, count - sent);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return 0;
+        }
+        sent += (size_t)n;
+    }
+    return 1;
+}
+
+void cleanup(void) {
+    if (game_state != NULL) {
+        munmap(game_state, game_state_size);
+        game_state = NULL;
+    }
+    
+    if (game_sync != NULL) {
+        munmap(game_sync, sizeof(GameSync));
+        game_sync = NULL;
+    }
+}
+
+void sig_handler(int signo) {
+    (void)signo;
+    cleanup();
+    exit(EXIT_SUCCESS);
+}
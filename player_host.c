@@ -0,0 +1,184 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/mman.h>
+#include "sharedMem.h"
+#include "player_utils.h"
+#include "remote.h"
+#include "rt.h"
+
+// Hosts several players in one process. Instead of being spawned by the
+// master it connects to its socket (slots given as "@" in -p), claims up to
+// -n slots and plays all of them with the player_simple strategy: every
+// grant packet is answered with a single packet holding one move per
+// granted slot.
+
+#define CONNECT_RETRY_US 100000   // The master may not be listening yet
+#define CONNECT_RETRIES 50
+
+GameState* game_state = NULL;
+GameSync* game_sync = NULL;
+size_t game_state_size = 0;
+int socket_fd = -1;
+MoveChooser choose_move = choose_best_move;  // Specialized for the board size once assigned
+
+int connect_to_master(const char* path);
+bool play_slots(const bool* granted, int slot_count);
+void cleanup(void);
+void sig_handler(int signo);
+
+int main(int argc, char* argv[]) {
+    const char* path = REMOTE_DEFAULT_PATH;
+    int wanted = 1;
+    int opt;
+    
+    while ((opt = getopt(argc, argv, "u:n:")) != -1) {
+        switch (opt) {
+            case 'u':
+                path = optarg;
+                break;
+            case 'n':
+                wanted = atoi(optarg);
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-u socket] [-n slots]\n", argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+    if (wanted < 1 || wanted > REMOTE_MAX_SLOTS) {
+        fprintf(stderr, "player_host: -n must be between 1 and %d\n", REMOTE_MAX_SLOTS);
+        exit(EXIT_FAILURE);
+    }
+    
+    signal(SIGINT, sig_handler);
+    signal(SIGTERM, sig_handler);
+    
+    socket_fd = connect_to_master(path);
+    if (socket_fd < 0) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    
+    RemotePacket packet;
+    memset(&packet, 0, sizeof(packet));
+    packet.type = PACKET_HELLO;
+    packet.count = wanted;
+    if (remote_send(socket_fd, &packet) != 0 || remote_recv(socket_fd, &packet, 1, false) != 1 ||
+        packet.type != PACKET_ASSIGN) {
+        fprintf(stderr, "player_host: no slots assigned\n");
+        cleanup();
+        exit(EXIT_FAILURE);
+    }
+    
+    // The assignment carries the board size a spawned player gets in argv
+    game_state_size = sizeof(GameState) + packet.width * packet.height * sizeof(int);
+    game_state = (GameState*)open_shared_memory(NAME_BOARD, game_state_size, O_RDONLY);
+    game_sync = (GameSync*)open_shared_memory(NAME_SYNC, sizeof(GameSync), O_RDWR);
+    choose_move = select_move_chooser(packet.width, packet.height);
+    
+    if (rt_mode() != RT_OFF) {
+        rt_prefault(game_state, game_state_size);
+        rt_prefault(game_sync, sizeof(GameSync));
+        rt_enter(RT_PRIORITY_CHILD);
+    }
+    
+    // Every assigned slot may move right away
+    bool granted[REMOTE_MAX_SLOTS] = {false};
+    for (int i = 0; i < packet.count; i++) {
+        granted[packet.slot[i]] = true;
+    }
+    
+    bool playing = true;
+    while (playing && play_slots(granted, REMOTE_MAX_SLOTS)) {
+        memset(granted, 0, sizeof(granted));
+        RemotePacket packets[REMOTE_RECV_BATCH];
+        int n = remote_recv(socket_fd, packets, REMOTE_RECV_BATCH, false);
+        if (n < 0 && errno == EAGAIN) {
+            continue;
+        }
+        if (n <= 0) {
+            break; // The master is gone
+        }
+        
+        // Grants that arrived together are answered together
+        for (int i = 0; i < n; i++) {
+            if (packets[i].type == PACKET_END) {
+                playing = false;
+            } else if (packets[i].type == PACKET_GRANT) {
+                for (int g = 0; g < packets[i].count; g++) {
+                    if (packets[i].slot[g] < REMOTE_MAX_SLOTS) {
+                        granted[packets[i].slot[g]] = true;
+                    }
+                }
+            }
+        }
+    }
+    
+    cleanup();
+    return 0;
+}
+
+int connect_to_master(const char* path) {
+    for (int attempt = 0; attempt < CONNECT_RETRIES; attempt++) {
+        int fd = remote_connect(path);
+        if (fd >= 0 || (errno != ENOENT && errno != ECONNREFUSED)) {
+            return fd;
+        }
+        usleep(CONNECT_RETRY_US);
+    }
+    return -1;
+}
+
+/* Choose a move for every granted slot and send them in one packet.
+ * Returns false once the game is over or the master is gone.
+ */
+bool play_slots(const bool* granted, int slot_count) {
+    RemotePacket moves;
+    
+    memset(&moves, 0, sizeof(moves));
+    moves.type = PACKET_MOVES;
+    for (int slot = 0; slot < slot_count; slot++) {
+        if (!granted[slot]) {
+            continue;
+        }
+        BoardWindow window;
+        snapshot_window(game_state, game_sync, slot, LOOKAHEAD_DISTANCE, &window);
+        if (window.game_over) {
+            return false;
+        }
+        moves.slot[moves.count] = slot;
+        moves.direction[moves.count] = choose_move(&window);
+        moves.count++;
+    }
+    
+    return moves.count == 0 || remote_send(socket_fd, &moves) == 0;
+}
+
+void cleanup(void) {
+    if (socket_fd >= 0) {
+        close(socket_fd);
+        socket_fd = -1;
+    }
+    if (game_state != NULL) {
+        munmap(game_state, game_state_size);
+        game_state = NULL;
+    }
+    if (game_sync != NULL) {
+        munmap(game_sync, sizeof(GameSync));
+        game_sync = NULL;
+    }
+}
+
+void sig_handler(int signo) {
+    (void)signo;
+    cleanup();
+    exit(EXIT_SUCCESS);
+}
\ No newline at end of file
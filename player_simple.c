@@ -11,19 +11,71 @@
 #include <semaphore.h>
 #include <signal.h>
 #include <errno.h>
+#include <pthread.h>
 #include "sharedMem.h"
+#include "rt.h"
+#include "player_utils.h"
+#include "trace.h"
+#include "pool.h"
+#include "metrics.h"
 
-// Directions: UP, UP-RIGHT, RIGHT, DOWN-RIGHT, DOWN, DOWN-LEFT, LEFT, UP-LEFT
-int vector[][2] = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}}; 
+#define PID_LOOKUP_RETRIES 100
+#define SPECULATION_RADIUS (LOOKAHEAD_DISTANCE + 2)  // A predicted window can seed the next prediction
 
 // Global variables for cleanup
 GameState* game_state = NULL;
 GameSync* game_sync = NULL;
+const HintTable* game_hints = NULL;  // Master's per-player hints, when it publishes them
 size_t game_state_size = 0;
 int player_idx = -1;
+MoveChooser choose_move = choose_best_move;  // Specialized for the board size in main()
+
+/* Speculative follow-up moves. While the master handles the move just sent,
+ * a helper thread works out the next move for both outcomes (applied or
+ * rejected). When the turn comes back, the main thread checks which outcome
+ * happened, from its own move count and position, and that its neighbours
+ * are still as predicted, then sends the precomputed move. Other players
+ * may have moved meanwhile: a capture elsewhere cannot change a choice made
+ * among the neighbours, and with no free neighbour every move is invalid.
+ *
+ * Snapshots are taken with SPECULATION_RADIUS, so an applied outcome still
+ * has a ring beyond the look-ahead and a hit is sent without reading the
+ * board, then seeds the next prediction. A window without that ring ends the
+ * chain, and so does a helper that has not finished when the turn comes
+ * back: waiting for it would cost more than deciding from a fresh snapshot.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    unsigned long submitted;      // Jobs handed to the helper
+    unsigned long finished;       // Jobs the helper completed
+    unsigned long abandoned;      // Job the main thread stopped waiting for
+    bool valid;                   // Whether the finished job produced usable predictions
+    BoardWindow base;             // Window the pending move was chosen from
+    unsigned char sent_move;      // Move sent to the master
+    BoardWindow outcome[2];       // Predicted windows: [0] move applied, [1] move rejected
+    unsigned char next_move[2];   // Follow-up move for each outcome
+    
+    // Main thread only: how often a prediction was ready and how often it held
+    unsigned long predictions;
+    unsigned long hits;
+} Speculation;
+
+/* Turn-to-write time of the moves that did not come from a hint */
+typedef struct {
+    unsigned long turns;
+    unsigned long long decide_ns;
+} DecideStats;
+
+Speculation speculation = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, 0, 0, false};
+unsigned long turns = 0, hinted_turns = 0;
+DecideStats speculated = {0, 0}, snapshotted = {0, 0};
 
 // Function prototypes
-unsigned char choose_best_move();
+void* speculation_worker(void* arg);
+void submit_speculation(const BoardWindow* window, unsigned char move);
+bool take_speculative_move(BoardWindow* window, unsigned char* move);
+bool next_game(void);
 void cleanup();
 void sig_handler(int signo);
 
@@ -35,6 +87,7 @@ int main(int argc, char* argv[]) {
     
     int width = atoi(argv[1]);
     int height = atoi(argv[2]);
+    choose_move = select_move_chooser(width, height);
     
     // Set up signal handlers for clean termination
     signal(SIGINT, sig_handler);
@@ -68,13 +121,21 @@ int main(int argc, char* argv[]) {
         }
     }
     
-    // Find player index
+    game_hints = hints_attach();
+    
+    // Find player index (the master may still be recording our pid right after spawn)
     if (game_state != NULL) {
         pid_t pid = getpid();
-        for (player_idx = 0; player_idx < game_state->player_count; player_idx++) {
-            if (game_state->players[player_idx].pid == pid) {
+        for (int attempt = 0; attempt < PID_LOOKUP_RETRIES; attempt++) {
+            for (player_idx = 0; player_idx < game_state->player_count; player_idx++) {
+                if (game_state->players[player_idx].pid == pid) {
+                    break;
+                }
+            }
+            if (player_idx < game_state->player_count) {
                 break;
             }
+            usleep(1000);
         }
         
         if (player_idx >= game_state->player_count) {
@@ -85,51 +146,101 @@ int main(int argc, char* argv[]) {
         player_idx = getpid() % 9;
     }
     
+    // Spans for the master's -T. Moves are numbered the way the master numbers
+    // them, by the player's valid plus invalid moves so far
+    char trace_name[16];
+    unsigned long long moves_sent = 0;
+    snprintf(trace_name, sizeof(trace_name), "player %d", player_idx);
+    trace_init(trace_name);
+    if (game_state != NULL) {
+        moves_sent = game_state->players[player_idx].valid_moves +
+                     game_state->players[player_idx].invalid_moves;
+    }
+    
+    // Low-jitter mode requested through the master's -R
+    if (rt_mode() != RT_OFF && game_state != NULL && game_sync != NULL) {
+        rt_prefault(game_state, game_state_size);
+        rt_prefault(game_sync, sizeof(GameSync));
+        rt_enter(RT_PRIORITY_CHILD);
+    }
+    
+    signal_ready(game_sync);
+    
     // Seed random number generator
     srand(time(NULL) ^ getpid());
     
+    pthread_t helper;
+    if (game_state != NULL && game_sync != NULL &&
+        pthread_create(&helper, NULL, speculation_worker, NULL) == 0) {
+        pthread_detach(helper); // Only touches private copies, never shared memory
+    }
+    
     // Main game loop
+    bool granted = false; // A pooled restart already took this turn's grant
     while (1) {
         // Wait for turn
-        if (game_sync != NULL) {
-            sem_wait(&game_sync->player_move_sem[player_idx]);
+        unsigned long long turn_ns = TRACE_NOW();
+        if (game_sync != NULL && !granted) {
+            sync_wait(&game_sync->player_move_sem[player_idx]);
         }
+        granted = false;
+        unsigned long long decide_ns = TRACE_NOW();
+        trace_span("wait_turn", turn_ns, decide_ns, moves_sent);
 
         if (game_state != NULL && game_sync != NULL) {
-            // Reader enters critical section
-            sem_wait(&game_sync->reader_count_mutex);
-            game_sync->readers_count++;
-            if (game_sync->readers_count == 1) {  
-                sem_wait(&game_sync->game_state_mutex);
-            }
-            sem_post(&game_sync->reader_count_mutex);
-
-            // Read game_over flag first
-            int game_over = game_state->game_over;
-
-            if (game_over) {
-                sem_wait(&game_sync->reader_count_mutex);
-                game_sync->readers_count--;
-                if (game_sync->readers_count == 0) {
-                   sem_post(&game_sync->game_state_mutex);
+            if (game_state->game_over) {
+                if (next_game()) {
+                    granted = true;
+                    moves_sent = 0;
+                    continue;
                 }
-                sem_post(&game_sync->reader_count_mutex);
                 break;
             }
 
-            unsigned char move = choose_best_move();
-
-            sem_wait(&game_sync->reader_count_mutex);
-            game_sync->readers_count--;
-            if (game_sync->readers_count == 0) {
-               sem_post(&game_sync->game_state_mutex);
+            // Fastest path: the master's hint shows a free neighbour, no board read or lock.
+            // Next: the helper already decided, we only validate the generation
+            BoardWindow window;
+            MoveHint hint;
+            unsigned char move;
+            bool hinted = game_hints != NULL && hints_read(game_hints, player_idx, &hint) &&
+                          choose_hinted_move(&hint, &move);
+            turns++;
+            hinted_turns += hinted;
+            unsigned long long start_ns = hinted ? 0 : metrics_now_ns();
+            bool speculative = !hinted && take_speculative_move(&window, &move);
+            if (!hinted && !speculative) {
+                // Copy only the neighbourhood we look at; the reader lock is a fallback
+                snapshot_window(game_state, game_sync, player_idx, SPECULATION_RADIUS, &window);
+                if (window.game_over) {
+                    if (next_game()) {
+                        granted = true;
+                        moves_sent = 0;
+                        continue;
+                    }
+                    break;
+                }
+                move = choose_move(&window);
+            }
+            if (!hinted) {
+                DecideStats* stats = speculative ? &speculated : &snapshotted;
+                stats->turns++;
+                stats->decide_ns += metrics_now_ns() - start_ns;
             }
-            sem_post(&game_sync->reader_count_mutex);
 
             // Send move to master through stdout
+            unsigned long long write_ns = TRACE_NOW();
+            trace_span("decide", decide_ns, write_ns, moves_sent);
+            trace_flow("move", true, TRACE_MOVE_FLOW(player_idx, moves_sent), write_ns);
             if (write(STDOUT_FILENO, &move, sizeof(unsigned char)) != 1) {
                 break;
             }
+            trace_span("write", write_ns, TRACE_NOW(), moves_sent);
+            moves_sent++;
+            if (hinted || window.radius <= LOOKAHEAD_DISTANCE) {
+                // A hint is as cheap as a prediction; a window without the extra ring cannot predict
+                continue;
+            }
+            submit_speculation(&window, move);
         } else {
             // Fallback when we don't have shared memory access
             unsigned char move = rand() % 8;
@@ -140,100 +251,139 @@ int main(int argc, char* argv[]) {
         }
     }
     
+    if (turns > 0) {
+        fprintf(stderr, "Player %d: %lu turns, %lu from hints, %lu/%lu speculative moves used, "
+                "decide avg %.0f ns speculative vs %.0f ns from a snapshot\n",
+                player_idx, turns, hinted_turns, speculation.hits, speculation.predictions,
+                speculated.turns ? (double)speculated.decide_ns / speculated.turns : 0.0,
+                snapshotted.turns ? (double)snapshotted.decide_ns / snapshotted.turns : 0.0);
+    }
+    
     // Clean up
     cleanup();
     return 0;
 }
 
-unsigned char choose_best_move() {
-    // If we can't access the game state, return a random move
-    if (game_state == NULL) {
-        return rand() % 8;
+void* speculation_worker(void* arg) {
+    (void)arg;
+    unsigned long seen = 0;
+    
+    pthread_mutex_lock(&speculation.lock);
+    while (1) {
+        while (speculation.submitted == seen) {
+            pthread_cond_wait(&speculation.cond, &speculation.lock);
+        }
+        seen = speculation.submitted;
+        BoardWindow base = speculation.base;
+        unsigned char sent = speculation.sent_move;
+        pthread_mutex_unlock(&speculation.lock);
+        
+        BoardWindow outcome[2];
+        unsigned char next_move[2];
+        bool applied_possible = WINDOW_CELL(&base, vector[sent][0], vector[sent][1]) > 0;
+        
+        predict_window(&base, player_idx, sent, true, &outcome[0]);
+        predict_window(&base, player_idx, sent, false, &outcome[1]);
+        next_move[0] = applied_possible ? choose_move(&outcome[0]) : 0;
+        next_move[1] = choose_move(&outcome[1]);
+        
+        pthread_mutex_lock(&speculation.lock);
+        if (speculation.submitted == seen && speculation.abandoned != seen) {
+            speculation.outcome[0] = outcome[0];
+            speculation.outcome[1] = outcome[1];
+            speculation.next_move[0] = next_move[0];
+            speculation.next_move[1] = next_move[1];
+            speculation.valid = true;
+        }
+        speculation.finished = seen;
+        pthread_cond_broadcast(&speculation.cond);
     }
+    return NULL;
+}
 
-    int width = game_state->width;
-    int height = game_state->height;
-    int player_x = game_state->players[player_idx].x;
-    int player_y = game_state->players[player_idx].y;
-    
-    // First, look for the highest reward in adjacent cells
-    int max_reward = -1;
-    unsigned char best_dir = 0;
-    
-    for (unsigned char dir = 0; dir < 8; dir++) {
-        int new_x = player_x + vector[dir][0];
-        int new_y = player_y + vector[dir][1];
+void submit_speculation(const BoardWindow* window, unsigned char move) {
+    pthread_mutex_lock(&speculation.lock);
+    speculation.base = *window;
+    speculation.sent_move = move;
+    speculation.valid = false;
+    speculation.submitted++;
+    pthread_cond_broadcast(&speculation.cond);
+    pthread_mutex_unlock(&speculation.lock);
+}
+
+/* Whether the cells around the window center still hold what the window says */
+static bool neighbours_unchanged(const BoardWindow* window) {
+    for (int dir = 0; dir < 8; dir++) {
+        int x = window->center_x + vector[dir][0];
+        int y = window->center_y + vector[dir][1];
+        int expected = WINDOW_CELL(window, vector[dir][0], vector[dir][1]);
         
-        // Check if the new position is valid (within bounds)
-        if (new_x >= 0 && new_x < width && new_y >= 0 && new_y < height) {
-            int cell_value = game_state->board[new_y * width + new_x];
-            
-            // If cell is free and has a reward
-            if (cell_value > 0) {
-                if (cell_value > max_reward) {
-                    max_reward = cell_value;
-                    best_dir = dir;
-                }
+        if (x < 0 || x >= window->width || y < 0 || y >= window->height) {
+            if (expected != WINDOW_OUTSIDE) {
+                return false;
             }
+        } else if (__atomic_load_n(&game_state->board[y * window->width + x], __ATOMIC_RELAXED) != expected) {
+            return false;
         }
     }
+    return true;
+}
+
+bool take_speculative_move(BoardWindow* window, unsigned char* move) {
+    bool hit = false;
     
-    // If we found a valid move with a reward, use it
-    unsigned char result_move = best_dir;
-    
-    // If no good moves in adjacent cells, look further (up to 3 steps away)
-    if (max_reward <= 0) {
-        for (int distance = 2; distance <= 3; distance++) {
-            for (unsigned char dir = 0; dir < 8; dir++) {
-                int new_x = player_x + (vector[dir][0] * distance);
-                int new_y = player_y + (vector[dir][1] * distance);
-                
-                // Check if the new position is valid
-                if (new_x >= 0 && new_x < width && new_y >= 0 && new_y < height) {
-                    int cell_value = game_state->board[new_y * width + new_x];
-                    
-                    // If cell is free and has a reward, consider the direction to move
-                    if (cell_value > 0) {
-                        // Discount rewards by distance
-                        int adjusted_reward = cell_value / distance;
-                        
-                        if (adjusted_reward > max_reward) {
-                            max_reward = adjusted_reward;
-                            // Still move in the original direction
-                            result_move = dir;
-                        }
-                    }
-                }
-            }
-        }
+    pthread_mutex_lock(&speculation.lock);
+    if (speculation.finished != speculation.submitted) {
+        speculation.abandoned = speculation.submitted; // Late: its result would be stale
+        pthread_mutex_unlock(&speculation.lock);
+        return false;
     }
     
-    // If still no good move found, choose a random direction that stays in bounds
-    if (max_reward <= 0) {
-        unsigned char random_dir = rand() % 8;
+    if (speculation.valid) {
+        // Our own Player entry only changes when the master handles our move, which it has
+        const Player* me = &game_state->players[player_idx];
+        unsigned int handled = me->valid_moves + me->invalid_moves;
         
-        // Try to avoid moving outside the board if possible
-        for (int i = 0; i < 8; i++) {
-            unsigned char dir = (random_dir + i) % 8;
-            int new_x = player_x + vector[dir][0];
-            int new_y = player_y + vector[dir][1];
-            
-            if (new_x >= 0 && new_x < width && new_y >= 0 && new_y < height) {
-                result_move = dir;
-                break;
+        speculation.predictions++;
+        for (int k = 0; k < 2 && !hit; k++) {
+            const BoardWindow* outcome = &speculation.outcome[k];
+            const Player* predicted = &outcome->players[player_idx];
+            if (outcome->center_x == me->x && outcome->center_y == me->y &&
+                predicted->valid_moves + predicted->invalid_moves == handled &&
+                neighbours_unchanged(outcome)) {
+                *window = *outcome;
+                *move = speculation.next_move[k];
+                hit = true;
             }
         }
-        
-        // If all directions go out of bounds, use the original random direction
-        if (max_reward <= 0) {
-            result_move = random_dir;
-        }
+        speculation.hits += hit;
+        speculation.valid = false;
     }
+    pthread_mutex_unlock(&speculation.lock);
     
-    return result_move;
+    return hit;
+}
+
+/* With the master's -g, wait for the next game instead of exiting. Whatever
+ * the helper predicted belongs to the old board.
+ */
+bool next_game(void) {
+    if (!pool_enabled() || !pool_park(game_state, game_sync, player_idx)) {
+        return false;
+    }
+    
+    pthread_mutex_lock(&speculation.lock);
+    while (speculation.finished != speculation.submitted) {
+        pthread_cond_wait(&speculation.cond, &speculation.lock);
+    }
+    speculation.valid = false;
+    pthread_mutex_unlock(&speculation.lock);
+    return true;
 }
 
 void cleanup() {
+    trace_finish();
+    
     if (game_state != NULL) {
         munmap(game_state, game_state_size);
         game_state = NULL;
@@ -243,6 +393,9 @@ void cleanup() {
         munmap(game_sync, sizeof(GameSync));
         game_sync = NULL;
     }
+    
+    hints_detach(game_hints);
+    game_hints = NULL;
 }
 
 void sig_handler(int signo) {
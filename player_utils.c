@@ -0,0 +1,189 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include "player_utils.h"
+#include "kernels.h"
+
+// Directions: UP, UP-RIGHT, RIGHT, DOWN-RIGHT, DOWN, DOWN-LEFT, LEFT, UP-LEFT
+const int vector[8][2] = {{0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}};
+
+// The same directions as linear offsets inside a BoardWindow
+static const int window_offset[8] = {
+    -WINDOW_SIDE, -WINDOW_SIDE + 1, 1, WINDOW_SIDE + 1,
+    WINDOW_SIDE, WINDOW_SIDE - 1, -1, -WINDOW_SIDE - 1
+};
+
+/* Random direction, preferring one that stays on the board */
+static unsigned char random_move(const int* center) {
+    unsigned char random_dir = rand() % 8;
+    
+    // Try to avoid moving outside the board if possible
+    for (int i = 0; i < 8; i++) {
+        unsigned char dir = (random_dir + i) % 8;
+        
+        if (center[window_offset[dir]] != WINDOW_OUTSIDE) {
+            return dir;
+        }
+    }
+    
+    // If all directions go out of bounds, use the original random direction
+    return random_dir;
+}
+
+unsigned char choose_best_move(const BoardWindow* window) {
+    // If we can't access the game state, return a random move
+    if (window == NULL) {
+        return rand() % 8;
+    }
+    
+    // The window border (WINDOW_OUTSIDE) acts as sentinel cells around the board
+    const int* center = &WINDOW_CELL(window, 0, 0);
+    
+    // First, look for the highest reward in adjacent cells
+    int max_reward = -1;
+    unsigned char best_dir = 0;
+    
+    for (unsigned char dir = 0; dir < 8; dir++) {
+        int cell_value = center[window_offset[dir]];
+        
+        // If cell is free and has a reward
+        if (cell_value > 0) {
+            if (cell_value > max_reward) {
+                max_reward = cell_value;
+                best_dir = dir;
+            }
+        }
+    }
+    
+    // If we found a valid move with a reward, use it
+    unsigned char result_move = best_dir;
+    
+    // If no good moves in adjacent cells, look further (up to 3 steps away)
+    if (max_reward <= 0) {
+        for (int distance = 2; distance <= LOOKAHEAD_DISTANCE; distance++) {
+            for (unsigned char dir = 0; dir < 8; dir++) {
+                int cell_value = center[window_offset[dir] * distance];
+                
+                // If cell is free and has a reward, consider the direction to move
+                if (cell_value > 0) {
+                    // Discount rewards by distance
+                    int adjusted_reward = cell_value / distance;
+                    
+                    if (adjusted_reward > max_reward) {
+                        max_reward = adjusted_reward;
+                        // Still move in the original direction
+                        result_move = dir;
+                    }
+                }
+            }
+        }
+    }
+    
+    // If still no good move found, choose a random direction that stays in bounds
+    if (max_reward <= 0) {
+        result_move = random_move(center);
+    }
+    
+    return result_move;
+}
+
+#if LOOKAHEAD_DISTANCE != 3
+#error "choose_best_move_unrolled() hard-codes a look-ahead of 3 cells"
+#endif
+
+/* Probe the cell distance steps away in direction dir, with the same
+ * discount and tie-breaking (first direction wins) as choose_best_move()
+ */
+#define PROBE(dir, distance, best)                                      \
+    do {                                                                \
+        int value_ = center[window_offset_##dir * (distance)];         \
+        if (value_ > 0 && value_ / (distance) > max_reward) {           \
+            max_reward = value_ / (distance);                           \
+            best = dir;                                                 \
+        }                                                               \
+    } while (0)
+
+#define PROBE_RING(distance, best)                                      \
+    do {                                                                \
+        PROBE(0, distance, best); PROBE(1, distance, best);             \
+        PROBE(2, distance, best); PROBE(3, distance, best);             \
+        PROBE(4, distance, best); PROBE(5, distance, best);             \
+        PROBE(6, distance, best); PROBE(7, distance, best);             \
+    } while (0)
+
+enum {
+    window_offset_0 = -WINDOW_SIDE, window_offset_1 = -WINDOW_SIDE + 1,
+    window_offset_2 = 1, window_offset_3 = WINDOW_SIDE + 1,
+    window_offset_4 = WINDOW_SIDE, window_offset_5 = WINDOW_SIDE - 1,
+    window_offset_6 = -1, window_offset_7 = -WINDOW_SIDE - 1
+};
+
+unsigned char choose_best_move_unrolled(const BoardWindow* window) {
+    if (window == NULL) {
+        return rand() % 8;
+    }
+    
+    const int* center = &WINDOW_CELL(window, 0, 0);
+    int max_reward = -1;
+    unsigned char result_move = 0;
+    
+    PROBE_RING(1, result_move);
+    if (max_reward <= 0) {
+        PROBE_RING(2, result_move);
+        PROBE_RING(3, result_move);
+    }
+    if (max_reward <= 0) {
+        result_move = random_move(center);
+    }
+    
+    return result_move;
+}
+
+bool choose_hinted_move(const MoveHint* hint, unsigned char* move) {
+    int max_reward = 0;
+    
+    for (unsigned char dir = 0; dir < 8; dir++) {
+        if ((hint->free_mask >> dir & 1) && hint->reward[dir] > max_reward) {
+            max_reward = hint->reward[dir];
+            *move = dir;
+        }
+    }
+    return max_reward > 0;
+}
+
+MoveChooser select_move_chooser(int width, int height) {
+    return kernels_specialized(width, height) ? choose_best_move_unrolled : choose_best_move;
+}
+
+void predict_window(const BoardWindow* window, int player_idx, unsigned char dir,
+                    bool applied, BoardWindow* out) {
+    *out = *window;
+    out->generation = window->generation + GENERATIONS_PER_MOVE;
+    if (!applied) {
+        out->players[player_idx].invalid_moves++;
+        return;
+    }
+    
+    int step_x = vector[dir][0];
+    int step_y = vector[dir][1];
+    int reward = WINDOW_CELL(window, step_x, step_y);
+    int radius = window->radius - 1;
+    
+    // Re-center on the target cell; the outer ring of the old window is lost
+    for (int dy = -WINDOW_MAX_RADIUS; dy <= WINDOW_MAX_RADIUS; dy++) {
+        for (int dx = -WINDOW_MAX_RADIUS; dx <= WINDOW_MAX_RADIUS; dx++) {
+            bool known = dx >= -radius && dx <= radius && dy >= -radius && dy <= radius;
+            WINDOW_CELL(out, dx, dy) = known ? WINDOW_CELL(window, dx + step_x, dy + step_y) : 0;
+        }
+    }
+    WINDOW_CELL(out, 0, 0) = -player_idx;
+    
+    out->radius = radius;
+    out->center_x += step_x;
+    out->center_y += step_y;
+    out->players[player_idx].x = out->center_x;
+    out->players[player_idx].y = out->center_y;
+    out->players[player_idx].score += reward;
+    out->players[player_idx].valid_moves++;
+}
@@ -0,0 +1,69 @@
+#ifndef PLAYER_UTILS_H
+#define PLAYER_UTILS_H
+
+#include "sharedMem.h"
+#include "hints.h"
+
+#define LOOKAHEAD_DISTANCE 3
+
+// Movement directions, in the order the master expects them
+extern const int vector[8][2];
+
+/**
+ * @brief Choose the next move from a local window of the board.
+ *
+ * Greedy: best adjacent reward, else the best distance-discounted reward up
+ * to LOOKAHEAD_DISTANCE cells away, else a random direction.
+ * @param window Window centered on the player, or NULL if no state is available.
+ * @return Direction to move (0-7).
+ */
+unsigned char choose_best_move(const BoardWindow* window);
+
+/* Signature shared by choose_best_move() and its specialized variant */
+typedef unsigned char (*MoveChooser)(const BoardWindow* window);
+
+/**
+ * @brief choose_best_move() with both direction loops fully unrolled.
+ *
+ * Picks the same moves. Window offsets are constants of the window layout,
+ * so one instance serves every specialized board size.
+ * @param window Window centered on the player, or NULL if no state is available.
+ * @return Direction to move (0-7).
+ */
+unsigned char choose_best_move_unrolled(const BoardWindow* window);
+
+/**
+ * @brief Pick the move chooser for a board, once at startup.
+ * @param width Board width.
+ * @param height Board height.
+ * @return choose_best_move_unrolled() for sizes with specialized kernels, else choose_best_move().
+ */
+MoveChooser select_move_chooser(int width, int height);
+
+/**
+ * @brief Pick the best adjacent move from the master's hint, without reading the board.
+ *
+ * Same choice and tie-breaking as choose_best_move() whenever a neighbour
+ * has a reward; the look-ahead and the random fallback need the board.
+ * @param hint The player's hint, from hints_read().
+ * @param move Chosen direction (0-7).
+ * @return true if a neighbour is free, false if the caller has to look further.
+ */
+bool choose_hinted_move(const MoveHint* hint, unsigned char* move);
+
+/**
+ * @brief Predict the window the player will see once the master has handled a move.
+ *
+ * Assumes no other player moves in between. A window of radius r predicts a
+ * window of radius r - 1 exactly, so snapshot with LOOKAHEAD_DISTANCE + 1;
+ * with LOOKAHEAD_DISTANCE + 2 the prediction can itself be predicted from.
+ * @param window Window the move was chosen from.
+ * @param player_idx Index of the player making the move.
+ * @param dir Direction that was sent.
+ * @param applied Whether to predict an accepted (true) or rejected (false) move.
+ * @param out Predicted window.
+ */
+void predict_window(const BoardWindow* window, int player_idx, unsigned char dir,
+                    bool applied, BoardWindow* out);
+
+#endif // PLAYER_UTILS_H
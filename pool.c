@@ -0,0 +1,24 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include "pool.h"
+
+bool pool_enabled(void) {
+    return getenv(POOL_ENV) != NULL;
+}
+
+bool pool_park(const GameState* state, GameSync* sync, int player_idx) {
+    unsigned int finished = __atomic_load_n(&state->game_id, __ATOMIC_ACQUIRE);
+    
+    sync_post(&sync->ready_sem);
+    while (1) {
+        sync_wait(&sync->player_move_sem[player_idx]);
+        if (__atomic_load_n(&state->pool_closed, __ATOMIC_ACQUIRE)) {
+            return false;
+        }
+        if (__atomic_load_n(&state->game_id, __ATOMIC_ACQUIRE) != finished) {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stdbool.h>
+#include "structs.h"
+
+/* Warm player pool. The master's -g sets POOL_ENV; a player that knows the
+ * protocol then parks at game over instead of exiting, and the master hands
+ * it the next game on the same shared memory. Parking is announced on
+ * ready_sem. The master resets the board, bumps game_id and grants each
+ * player its first move; pool_closed tells parked players to leave.
+ */
+#define POOL_ENV "CHOMP_POOL"
+
+/**
+ * @brief Whether this process was started by a pooled master.
+ * @return true if POOL_ENV is set.
+ */
+bool pool_enabled(void);
+
+/**
+ * @brief Announce game over to the master and wait for the next game.
+ *
+ * Grants left over from the finished game are swallowed. On return with
+ * true the grant of the new game's first move has been consumed already.
+ * @param state Mapped game state.
+ * @param sync Mapped synchronization segment.
+ * @param player_idx This player's index (the same in every game).
+ * @return true when a new game started, false when the pool is closing.
+ */
+bool pool_park(const GameState* state, GameSync* sync, int player_idx);
+
+#endif // POOL_H
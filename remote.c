@@ -0,0 +1,125 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "remote.h"
+
+static int remote_address(const char* path, struct sockaddr_un* addr) {
+    memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr->sun_path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    strcpy(addr->sun_path, path);
+    return 0;
+}
+
+int remote_listen(const char* path) {
+    struct sockaddr_un addr;
+    
+    if (remote_address(path, &addr) != 0) {
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    
+    unlink(path); // Left behind by a master that did not exit cleanly
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(fd, REMOTE_MAX_SLOTS) != 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+}
+
+int remote_connect(const char* path) {
+    struct sockaddr_un addr;
+    
+    if (remote_address(path, &addr) != 0) {
+        return -1;
+    }
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+        int saved = errno;
+        close(fd);
+        errno = saved;
+        return -1;
+    }
+    return fd;
+}
+
+int remote_send(int fd, const RemotePacket* packet) {
+    ssize_t sent;
+    
+    do {
+        sent = send(fd, packet, sizeof(*packet), MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    return sent == (ssize_t)sizeof(*packet) ? 0 : -1;
+}
+
+int remote_recv(int fd, RemotePacket* packets, int max, bool nonblocking) {
+    struct mmsghdr messages[REMOTE_RECV_BATCH];
+    struct iovec vectors[REMOTE_RECV_BATCH];
+    
+    if (max > REMOTE_RECV_BATCH) {
+        max = REMOTE_RECV_BATCH;
+    }
+    memset(messages, 0, sizeof(messages));
+    for (int i = 0; i < max; i++) {
+        vectors[i].iov_base = &packets[i];
+        vectors[i].iov_len = sizeof(packets[i]);
+        messages[i].msg_hdr.msg_iov = &vectors[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    
+    // MSG_WAITFORONE: block for the first packet only
+    int n;
+    do {
+        n = recvmmsg(fd, messages, max, nonblocking ? MSG_DONTWAIT : MSG_WAITFORONE, NULL);
+    } while (n < 0 && errno == EINTR);
+    if (n < 0) {
+        return -1;
+    }
+    
+    // A zero-length packet is the end of the connection; drop malformed ones
+    int kept = 0;
+    for (int i = 0; i < n; i++) {
+        if (messages[i].msg_len == 0) {
+            return kept > 0 ? kept : 0;
+        }
+        if (messages[i].msg_len == sizeof(RemotePacket) && packets[i].count <= REMOTE_MAX_SLOTS) {
+            if (kept != i) {
+                packets[kept] = packets[i];
+            }
+            kept++;
+        }
+    }
+    if (kept == 0) {
+        errno = EAGAIN;
+        return -1;
+    }
+    return kept;
+}
+
+pid_t remote_peer_pid(int fd) {
+    struct ucred cred;
+    socklen_t len = sizeof(cred);
+    
+    if (getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &cred, &len) != 0) {
+        return -1;
+    }
+    return cred.pid;
+}
\ No newline at end of file
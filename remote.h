@@ -0,0 +1,78 @@
+#ifndef REMOTE_H
+#define REMOTE_H
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+/* Remote players: instead of being spawned with a pipe on stdout, a
+ * process connects to the master's SOCK_SEQPACKET socket and claims one or
+ * more player slots. One connection carries the moves of all its slots,
+ * and each packet may hold a move (or a grant) for several of them.
+ */
+#define REMOTE_DEFAULT_PATH "chomp.sock"
+#define REMOTE_SLOT "@"               // -p entry for a slot filled by a remote player
+#define REMOTE_MAX_SLOTS 9
+#define REMOTE_RECV_BATCH 16          // Packets taken per recvmmsg()
+
+typedef enum {
+    PACKET_HELLO = 'H',               // Client: count = slots wanted
+    PACKET_ASSIGN = 'A',              // Master: slots given (each may move at once), board size
+    PACKET_MOVES = 'M',               // Client: one direction per listed slot
+    PACKET_GRANT = 'G',               // Master: the listed slots may send their next move
+    PACKET_END = 'E'                  // Master: the game is over
+} PacketType;
+
+/* Every packet has this fixed layout; both ends run on the same host */
+typedef struct {
+    unsigned char type;               // PacketType
+    unsigned char count;              // Entries used in slot (and direction)
+    unsigned short width;             // PACKET_ASSIGN: board width
+    unsigned short height;            // PACKET_ASSIGN: board height
+    unsigned char slot[REMOTE_MAX_SLOTS];
+    unsigned char direction[REMOTE_MAX_SLOTS]; // PACKET_MOVES
+} RemotePacket;
+
+/**
+ * @brief Create the listening socket, replacing a stale socket file.
+ * @param path Filesystem path of the socket.
+ * @return The listening descriptor, or -1 with errno set.
+ */
+int remote_listen(const char* path);
+
+/**
+ * @brief Connect to a master's socket.
+ * @param path Filesystem path of the socket.
+ * @return The connected descriptor, or -1 with errno set.
+ */
+int remote_connect(const char* path);
+
+/**
+ * @brief Send one packet.
+ * @param fd Connected socket.
+ * @param packet Packet to send.
+ * @return 0 on success, -1 with errno set (EPIPE once the peer is gone).
+ */
+int remote_send(int fd, const RemotePacket* packet);
+
+/**
+ * @brief Receive up to max packets in one system call.
+ *
+ * Waits for the first packet unless nonblocking is set; the rest are only
+ * taken if already queued.
+ * @param fd Connected socket.
+ * @param packets Output packets.
+ * @param max Capacity of packets.
+ * @param nonblocking Return at once when nothing is queued.
+ * @return Packets received, 0 once the peer has closed the connection,
+ *         -1 with errno set (EAGAIN if nonblocking and nothing is queued).
+ */
+int remote_recv(int fd, RemotePacket* packets, int max, bool nonblocking);
+
+/**
+ * @brief Process ID of the peer of a connected socket.
+ * @param fd Connected socket.
+ * @return The peer's PID, or -1 if unknown.
+ */
+pid_t remote_peer_pid(int fd);
+
+#endif // REMOTE_H
\ No newline at end of file
@@ -0,0 +1,297 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "render.h"
+
+#define HEADER_BYTES 384      // Title, status, view and legend header lines
+#define PLAYER_LINE_BYTES 192 // One line of the player table or the legend
+#define STATS_BYTES 512       // Statistics block appended by render_stats()
+#define CELL_BYTES 20         // Longest colored cell, e.g. "\033[37;44m    8 \033[0m" (5-digit coordinates)
+#define MIN_LABEL_DIGITS 2    // Cells and labels are at least this wide, plus a space
+#define MIN_VIEW_CELLS 4      // Smallest viewport side, even on tiny terminals
+#define OVERVIEW_SAMPLES 4    // Cells sampled per axis for each overview glyph
+
+const char* player_colors[9] = {
+    "\033[31m",  // Red
+    "\033[34m",  // Blue
+    "\033[35m",  // Magenta
+    "\033[36m",  // Cyan
+    "\033[33m",  // Yellow
+    "\033[97m",  // White
+    "\033[37;44m", // White on blue
+    "\033[37;45m", // White on magenta
+    "\033[37;46m"  // White on cyan
+};
+
+typedef struct {
+    char* data;
+    size_t len;
+    size_t cap;
+} RenderBuffer;
+
+static void append(RenderBuffer* out, const char* fmt, ...) {
+    if (out->len + 1 >= out->cap) {
+        return;
+    }
+    
+    va_list args;
+    va_start(args, fmt);
+    int written = vsnprintf(out->data + out->len, out->cap - out->len, fmt, args);
+    va_end(args);
+    
+    if (written > 0) {
+        out->len += (size_t)written;
+        if (out->len >= out->cap) {
+            out->len = out->cap - 1; // Truncated
+        }
+    }
+}
+
+/* Digits of the largest coordinate below extent; cells and row labels are
+ * this wide, so coordinates of 100 and more stay aligned with their cells.
+ */
+static int label_digits(int extent) {
+    int digits = MIN_LABEL_DIGITS;
+    for (long limit = 100; extent - 1 >= limit; limit *= 10) {
+        digits++;
+    }
+    return digits;
+}
+
+size_t render_buffer_size(int width, int height, int player_count) {
+    return HEADER_BYTES + STATS_BYTES + 2 * (size_t)player_count * PLAYER_LINE_BYTES +
+           (size_t)(width + 1) * CELL_BYTES * (size_t)(height + 1) + 1;
+}
+
+static void render_header(RenderBuffer* out, const GameState* state) {
+    int player_count = state->player_count;
+    
+    append(out, "\033[2J\033[H");
+    
+    append(out, "===== ChompChamps =====\n");
+    append(out, "Game Status: %s\n", state->game_over ? "GAME OVER" : "IN PROGRESS");
+    append(out, "\n");
+    
+    append(out, "Players:\n");
+    for (int i = 0; i < player_count; i++) {
+        append(out, "\033%s[%d] %s - Score: %u, Position: (%u,%u), Valid Moves: %u, Invalid Moves: %u, %s\033[0m\n",
+               player_colors[i % 9], i, state->players[i].name, state->players[i].score,
+               state->players[i].x, state->players[i].y,
+               state->players[i].valid_moves, state->players[i].invalid_moves,
+               state->players[i].is_blocked ? "BLOCKED" : "ACTIVE");
+    }
+    append(out, "\n");
+}
+
+static void render_legend(RenderBuffer* out, const GameState* state) {
+    int player_count = state->player_count;
+    
+    append(out, "\nLegend:\n");
+    append(out, "\033[32m1-9\033[0m - Reward value\n");
+    
+    for (int i = 0; i < player_count && i < 9; i++) {
+        append(out, "%s%2d \033[0m - Player %d's captured cells\n", 
+               player_colors[i % 9], i, i);
+    }
+    
+    append(out, "\033[1;33m # \033[0m - Player's current position\n");
+}
+
+static void render_cell(RenderBuffer* out, int cell_value, bool player_present, int player_count,
+                        int digits) {
+    if (player_present) {
+        append(out, "\033[1;33m%*s \033[0m", digits, "#");
+        
+    } else if (cell_value > 0) { 
+        append(out, "\033[32m%*d \033[0m", digits, cell_value);
+
+    } else {
+        int owner = -cell_value;
+
+        if (owner >= 0 && owner <= player_count) { 
+
+            append(out, "%s%*d \033[0m", player_colors[owner % 9], digits, owner);
+
+        } else {
+            append(out, "\033[31m%*s \033[0m", digits, "?");
+        }
+    }
+}
+
+static bool player_at(const GameState* state, int x, int y) {
+    for (unsigned int i = 0; i < state->player_count; i++) {
+        if (state->players[i].x == x && state->players[i].y == y) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Majority vote over at most OVERVIEW_SAMPLES x OVERVIEW_SAMPLES cells of a
+ * block, so an overview glyph costs the same whatever the board size.
+ * Returns the reward (> 0) or owner encoding (<= 0) of the block.
+ */
+static int block_majority(const GameState* state, int x0, int y0, int block_w, int block_h,
+                          bool* player_present) {
+    int width = state->width;
+    int x1 = x0 + block_w > width ? width : x0 + block_w;
+    int y1 = y0 + block_h > state->height ? state->height : y0 + block_h;
+    int step_x = (x1 - x0 + OVERVIEW_SAMPLES - 1) / OVERVIEW_SAMPLES;
+    int step_y = (y1 - y0 + OVERVIEW_SAMPLES - 1) / OVERVIEW_SAMPLES;
+    int owners[9] = {0};
+    int free_cells = 0, reward_sum = 0;
+    
+    *player_present = false;
+    for (unsigned int i = 0; i < state->player_count; i++) {
+        if (state->players[i].x >= x0 && state->players[i].x < x1 &&
+            state->players[i].y >= y0 && state->players[i].y < y1) {
+            *player_present = true;
+        }
+    }
+    
+    for (int y = y0; y < y1; y += step_y) {
+        for (int x = x0; x < x1; x += step_x) {
+            int value = state->board[y * width + x];
+            if (value > 0) {
+                free_cells++;
+                reward_sum += value;
+            } else if (-value < 9) {
+                owners[-value]++;
+            }
+        }
+    }
+    
+    int best_owner = 0;
+    for (int i = 1; i < 9; i++) {
+        if (owners[i] > owners[best_owner]) {
+            best_owner = i;
+        }
+    }
+    if (free_cells >= owners[best_owner]) {
+        return free_cells > 0 ? (reward_sum + free_cells / 2) / free_cells : 1;
+    }
+    return -best_owner;
+}
+
+void render_view_fit(RenderView* view, const GameState* state, int term_cols, int term_rows) {
+    int width = state->width;
+    int height = state->height;
+    
+    // Header, player table, board title, status, coordinate row and legend
+    int reserved_rows = 11 + 2 * (int)state->player_count;
+    int cols = (term_cols - label_digits(height) - 1) / (label_digits(width) + 1);
+    int rows = term_rows - reserved_rows;
+    if (cols < MIN_VIEW_CELLS) cols = MIN_VIEW_CELLS;
+    if (rows < MIN_VIEW_CELLS) rows = MIN_VIEW_CELLS;
+    
+    if (view->overview) {
+        view->block_w = (width + cols - 1) / cols;
+        view->block_h = (height + rows - 1) / rows;
+        view->cols = (width + view->block_w - 1) / view->block_w;
+        view->rows = (height + view->block_h - 1) / view->block_h;
+        view->origin_x = 0;
+        view->origin_y = 0;
+        return;
+    }
+    
+    view->block_w = 1;
+    view->block_h = 1;
+    view->cols = cols < width ? cols : width;
+    view->rows = rows < height ? rows : height;
+    
+    if (view->follow >= 0 && view->follow < (int)state->player_count) {
+        view->origin_x = state->players[view->follow].x - view->cols / 2;
+        view->origin_y = state->players[view->follow].y - view->rows / 2;
+    }
+    
+    if (view->origin_x > width - view->cols) view->origin_x = width - view->cols;
+    if (view->origin_y > height - view->rows) view->origin_y = height - view->rows;
+    if (view->origin_x < 0) view->origin_x = 0;
+    if (view->origin_y < 0) view->origin_y = 0;
+}
+
+size_t render_viewport(const GameState* state, const RenderView* view, char* buf, size_t cap) {
+    RenderBuffer out = {buf, 0, cap};
+    int width = state->width;
+    int player_count = state->player_count;
+    int cell_digits = label_digits(width);
+    int row_digits = label_digits(state->height);
+    bool clipped = view->overview || view->cols < width || view->rows < state->height;
+    
+    if (cap == 0) {
+        return 0;
+    }
+    buf[0] = '\0';
+    
+    render_header(&out, state);
+    
+    append(&out, "Board:\n");
+    if (view->overview) {
+        append(&out, "Overview: 1 glyph = %dx%d cells (majority owner)\n", view->block_w, view->block_h);
+    } else if (clipped) {
+        append(&out, "View: x %d-%d, y %d-%d of %dx%d", view->origin_x,
+               view->origin_x + view->cols - 1, view->origin_y, view->origin_y + view->rows - 1,
+               width, state->height);
+        if (view->follow >= 0) {
+            append(&out, ", following player %d", view->follow);
+        }
+        append(&out, "\n");
+    }
+    
+    append(&out, "%*s ", row_digits, "");
+    for (int c = 0; c < view->cols; c++) {
+        append(&out, "%*d ", cell_digits, view->origin_x + c * view->block_w);
+    }
+    append(&out, "\n");
+    
+    for (int r = 0; r < view->rows; r++) {
+        int y = view->origin_y + r * view->block_h;
+        append(&out, "%*d ", row_digits, y);
+        for (int c = 0; c < view->cols; c++) {
+            int x = view->origin_x + c * view->block_w;
+            bool player_present;
+            int cell_value;
+            
+            if (view->overview) {
+                cell_value = block_majority(state, x, y, view->block_w, view->block_h, &player_present);
+            } else {
+                cell_value = state->board[y * width + x];
+                player_present = player_at(state, x, y);
+            }
+            render_cell(&out, cell_value, player_present, player_count, cell_digits);
+        }
+        append(&out, "\n");
+    }
+    
+    render_legend(&out, state);
+    
+    return out.len;
+}
+
+size_t render_game_state(const GameState* state, char* buf, size_t cap) {
+    RenderView full = {0, 0, state->width, state->height, 1, 1, false, -1};
+    return render_viewport(state, &full, buf, cap);
+}
+
+size_t render_stats(const BoardStats* stats, int player_count, char* buf, size_t cap) {
+    RenderBuffer out = {buf, 0, cap};
+    
+    if (cap > 0) {
+        buf[0] = '\0';
+    }
+    
+    append(&out, "\nTerritory:");
+    for (int i = 0; i < player_count && i < STATS_MAX_OWNERS; i++) {
+        append(&out, " %s[%d] %d\033[0m", player_colors[i % 9], i, stats->owned[i]);
+    }
+    append(&out, "\nFree: %d cells, %ld reward |", stats->free_cells, stats->free_reward);
+    for (int reward = 1; reward <= STATS_MAX_REWARD; reward++) {
+        append(&out, " %d:%d", reward, stats->reward_hist[reward]);
+    }
+    append(&out, "\n");
+    
+    return out.len;
+}
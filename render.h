@@ -0,0 +1,71 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stddef.h>
+#include "structs.h"
+#include "analytics.h"
+
+/* ANSI colors used for each player's cells */
+extern const char* player_colors[9];
+
+/* Part of the board shown on screen. In overview mode each glyph stands for
+ * a block_w x block_h block of cells.
+ */
+typedef struct {
+    int origin_x, origin_y;   // Top-left board cell shown
+    int cols, rows;           // Cells (or blocks) shown horizontally and vertically
+    int block_w, block_h;     // Cells per glyph (1x1 outside overview mode)
+    bool overview;            // Downsampled whole-board mode
+    int follow;               // Player kept centered, or -1 for manual scrolling
+} RenderView;
+
+/**
+ * @brief Fit a view to the terminal, recentering on the followed player and clamping to the board.
+ * @param view View to update; overview, follow and origin are inputs.
+ * @param state Pointer to the game state.
+ * @param term_cols Terminal width in columns.
+ * @param term_rows Terminal height in rows.
+ */
+void render_view_fit(RenderView* view, const GameState* state, int term_cols, int term_rows);
+
+/**
+ * @brief Render the screen showing only the cells (or overview blocks) in a view.
+ *
+ * The work done is proportional to the view, not to the board.
+ * @param state Pointer to the game state to render.
+ * @param view Part of the board to show, usually prepared by render_view_fit().
+ * @param buf Destination buffer.
+ * @param cap Capacity of buf in bytes.
+ * @return Number of bytes written, excluding the terminating NUL.
+ */
+size_t render_viewport(const GameState* state, const RenderView* view, char* buf, size_t cap);
+
+/**
+ * @brief Upper bound of the bytes render_game_state() can produce.
+ * @param width The width of the game board.
+ * @param height The height of the game board.
+ * @param player_count The number of players.
+ * @return Buffer size in bytes, including the terminating NUL.
+ */
+size_t render_buffer_size(int width, int height, int player_count);
+
+/**
+ * @brief Render the full game screen as ANSI text into a buffer.
+ * @param state Pointer to the game state to render.
+ * @param buf Destination buffer.
+ * @param cap Capacity of buf in bytes.
+ * @return Number of bytes written, excluding the terminating NUL.
+ */
+size_t render_game_state(const GameState* state, char* buf, size_t cap);
+
+/**
+ * @brief Render the territory, free-cell and reward-histogram lines.
+ * @param stats Totals from board_stats().
+ * @param player_count The number of players.
+ * @param buf Destination buffer.
+ * @param cap Capacity of buf in bytes.
+ * @return Number of bytes written, excluding the terminating NUL.
+ */
+size_t render_stats(const BoardStats* stats, int player_count, char* buf, size_t cap);
+
+#endif // RENDER_H
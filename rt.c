@@ -0,0 +1,127 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include "rt.h"
+
+static const char* const mode_names[] = {"off", "lock", "fifo"};
+
+int rt_parse_mode(const char* text, RtMode* mode) {
+    for (int i = RT_OFF; i <= RT_FIFO; i++) {
+        if (strcmp(text, mode_names[i]) == 0) {
+            *mode = (RtMode)i;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+const char* rt_mode_name(RtMode mode) {
+    return mode_names[mode];
+}
+
+RtMode rt_mode(void) {
+    const char* text = getenv(RT_ENV);
+    RtMode mode = RT_OFF;
+    
+    if (text != NULL && rt_parse_mode(text, &mode) != 0) {
+        mode = RT_OFF;
+    }
+    return mode;
+}
+
+/* Write to each page of a stack region this function is about to give back */
+static void prefault_stack(void) {
+    volatile unsigned char stack[RT_STACK_PREFAULT];
+    long page = sysconf(_SC_PAGESIZE);
+    
+    for (size_t i = 0; i < sizeof(stack); i += page) {
+        stack[i] = 0;
+    }
+}
+
+/* MCL_FUTURE locks every later mapping in full, thread stacks included;
+ * under a finite memlock limit that makes pthread_create fail, so only
+ * lock the future when the limit cannot be hit.
+ */
+static bool can_lock_future(void) {
+    struct rlimit limit;
+    
+    if (geteuid() == 0) {
+        return true;
+    }
+    return getrlimit(RLIMIT_MEMLOCK, &limit) == 0 && limit.rlim_cur == RLIM_INFINITY;
+}
+
+RtStatus rt_enter(int priority) {
+    RtStatus status;
+    
+    memset(&status, 0, sizeof(status));
+    status.mode = rt_mode();
+    if (status.mode == RT_OFF) {
+        return status;
+    }
+    
+    if (can_lock_future() && mlockall(MCL_CURRENT | MCL_FUTURE) == 0) {
+        status.locked = true;
+        status.locked_future = true;
+    } else if (mlockall(MCL_CURRENT) == 0) {
+        status.locked = true;
+    }
+    prefault_stack();
+    
+    if (status.mode == RT_FIFO) {
+        struct sched_param param;
+        memset(&param, 0, sizeof(param));
+        param.sched_priority = priority;
+        // Reset on fork: the checkpoint writer must not compete at RT priority
+        if (sched_setscheduler(0, SCHED_FIFO | SCHED_RESET_ON_FORK, &param) == 0) {
+            status.fifo = true;
+        } else {
+            status.fifo_error = errno;
+        }
+    }
+    return status;
+}
+
+void rt_prefault(const void* addr, size_t len) {
+    const volatile unsigned char* bytes = addr;
+    long page = sysconf(_SC_PAGESIZE);
+    
+    // Reading is enough: shared memory pages map writable on the first fault
+    for (size_t i = 0; i < len; i += page) {
+        (void)bytes[i];
+    }
+    if (len > 0) {
+        (void)bytes[len - 1];
+    }
+}
+
+void rt_deadline_after(struct timespec* deadline, long long ns) {
+    clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += ns / 1000000000LL;
+    deadline->tv_nsec += ns % 1000000000LL;
+    if (deadline->tv_nsec >= 1000000000L) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
+
+unsigned long long rt_sleep_until(const struct timespec* deadline) {
+    struct timespec now;
+    
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, deadline, NULL) == EINTR) {
+        // Absolute deadline: resuming does not add the time already slept
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long long late = (long long)(now.tv_sec - deadline->tv_sec) * 1000000000LL +
+                     (now.tv_nsec - deadline->tv_nsec);
+    return late > 0 ? (unsigned long long)late : 0;
+}
\ No newline at end of file
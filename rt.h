@@ -0,0 +1,86 @@
+#ifndef RT_H
+#define RT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <time.h>
+
+/* Opt-in low-jitter mode. The master's -R sets RT_ENV, and the view and the
+ * players spawned afterwards pick the same mode up from their environment.
+ */
+#define RT_ENV "CHOMP_RT"                 // off, lock or fifo
+#define RT_PRIORITY_MASTER 20             // SCHED_FIFO priority of the master's threads
+#define RT_PRIORITY_CHILD 10              // The view and the players yield to the master
+#define RT_STACK_PREFAULT (256 * 1024)    // Stack bytes touched up front
+
+typedef enum {
+    RT_OFF,                               // Normal scheduling, pages fault on demand
+    RT_LOCK,                              // mlockall and prefaulting
+    RT_FIFO                               // RT_LOCK plus SCHED_FIFO when permitted
+} RtMode;
+
+/* What rt_enter() managed to set up */
+typedef struct {
+    RtMode mode;                          // Requested mode
+    bool locked;                          // mlockall succeeded
+    bool locked_future;                   // ...including mappings created later
+    bool fifo;                            // Running under SCHED_FIFO
+    int fifo_error;                       // errno of the failed sched_setscheduler, 0 otherwise
+} RtStatus;
+
+/**
+ * @brief Parse a mode name.
+ * @param text "off", "lock" or "fifo".
+ * @param mode Parsed mode.
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int rt_parse_mode(const char* text, RtMode* mode);
+
+/**
+ * @brief Name of a mode, as accepted by rt_parse_mode().
+ */
+const char* rt_mode_name(RtMode mode);
+
+/**
+ * @brief Mode requested through RT_ENV, RT_OFF if unset or unknown.
+ */
+RtMode rt_mode(void);
+
+/**
+ * @brief Apply the mode requested through RT_ENV to the calling process.
+ *
+ * Locks the current mappings (and future ones when the memlock limit
+ * allows it), prefaults the stack and, in RT_FIFO mode, switches the
+ * calling thread to SCHED_FIFO. Threads created afterwards inherit the
+ * policy; forked children do not. Failures fall back silently to the
+ * next best setting and are reported in the returned status. Call after
+ * the shared memory segments are mapped.
+ * @param priority SCHED_FIFO priority to request.
+ * @return What was set up.
+ */
+RtStatus rt_enter(int priority);
+
+/**
+ * @brief Touch every page of a mapping so later accesses do not fault.
+ * @param addr Start of the mapping.
+ * @param len Length in bytes.
+ */
+void rt_prefault(const void* addr, size_t len);
+
+/**
+ * @brief Compute an absolute CLOCK_MONOTONIC deadline.
+ * @param deadline Set to now plus ns.
+ * @param ns Offset in nanoseconds.
+ */
+void rt_deadline_after(struct timespec* deadline, long long ns);
+
+/**
+ * @brief Sleep until an absolute CLOCK_MONOTONIC deadline.
+ *
+ * Signals do not stretch the sleep: it resumes towards the same deadline.
+ * @param deadline When to wake up.
+ * @return How late the wake-up was, in nanoseconds.
+ */
+unsigned long long rt_sleep_until(const struct timespec* deadline);
+
+#endif // RT_H
\ No newline at end of file
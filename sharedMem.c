@@ -90,4 +90,97 @@ void close_shared_memory(void* ptr, const char* name, size_t size) {
             perror("shm_unlink");
         }
     }
-}
\ No newline at end of file
+}
+
+void signal_ready(GameSync* sync) {
+    if (sync != NULL) {
+        sync_post(&sync->ready_sem);
+    }
+}
+
+void reader_enter(GameSync* sync) {
+    sync_wait(&sync->reader_count_mutex);
+    sync->readers_count++;
+    if (sync->readers_count == 1) {
+        sync_wait(&sync->game_state_mutex);
+    }
+    sync_post(&sync->reader_count_mutex);
+}
+
+void reader_exit(GameSync* sync) {
+    sync_wait(&sync->reader_count_mutex);
+    sync->readers_count--;
+    if (sync->readers_count == 0) {
+        sync_post(&sync->game_state_mutex);
+    }
+    sync_post(&sync->reader_count_mutex);
+}
+
+static void copy_window(const GameState* state, int player_idx, int radius, BoardWindow* out) {
+    int width = state->width;
+    int height = state->height;
+    
+    out->width = width;
+    out->height = height;
+    out->player_count = state->player_count;
+    out->game_over = state->game_over;
+    memcpy(out->players, state->players, sizeof(out->players));
+    
+    out->center_x = out->players[player_idx].x;
+    out->center_y = out->players[player_idx].y;
+    out->radius = radius;
+    
+    for (int dy = -radius; dy <= radius; dy++) {
+        int y = out->center_y + dy;
+        int* row = &WINDOW_CELL(out, 0, dy);
+        
+        if (y < 0 || y >= height) {
+            for (int dx = -radius; dx <= radius; dx++) {
+                row[dx] = WINDOW_OUTSIDE;
+            }
+            continue;
+        }
+        
+        // Copy the in-board span of the row in one go, pad the rest
+        int x_first = out->center_x - radius < 0 ? 0 : out->center_x - radius;
+        int x_last = out->center_x + radius >= width ? width - 1 : out->center_x + radius;
+        for (int dx = -radius; dx < x_first - out->center_x; dx++) {
+            row[dx] = WINDOW_OUTSIDE;
+        }
+        memcpy(&row[x_first - out->center_x], &state->board[y * width + x_first],
+               (x_last - x_first + 1) * sizeof(int));
+        for (int dx = x_last - out->center_x + 1; dx <= radius; dx++) {
+            row[dx] = WINDOW_OUTSIDE;
+        }
+    }
+}
+
+unsigned int snapshot_window(const GameState* state, GameSync* sync, int player_idx,
+                             int radius, BoardWindow* out) {
+    if (radius > WINDOW_MAX_RADIUS) {
+        radius = WINDOW_MAX_RADIUS;
+    }
+    
+    for (int attempt = 0; attempt < SNAPSHOT_OPTIMISTIC_TRIES; attempt++) {
+        unsigned int generation = __atomic_load_n(&sync->generation, __ATOMIC_ACQUIRE);
+        if (generation & 1) {
+            continue; // Master is mid-write
+        }
+        
+        copy_window(state, player_idx, radius, out);
+        
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&sync->generation, __ATOMIC_RELAXED) == generation) {
+            out->generation = generation;
+            return generation;
+        }
+    }
+    
+    // Heavy write traffic: take the reader lock so the copy cannot tear
+    reader_enter(sync);
+    copy_window(state, player_idx, radius, out);
+    out->generation = __atomic_load_n(&sync->generation, __ATOMIC_RELAXED);
+    reader_exit(sync);
+    
+    return out->generation;
+}
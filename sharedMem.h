@@ -4,8 +4,37 @@
 #include <stdbool.h>
 #include <semaphore.h>
 #include <sys/types.h>
+#include <limits.h>
 #include "structs.h"  
 
+/* Local board window copied by snapshot_window(). Cells are stored with a
+ * fixed stride and the player always at the center, so neighbour offsets
+ * are compile-time constants.
+ */
+#define WINDOW_MAX_RADIUS 5      // Look-ahead plus two rings, for chained speculation
+#define WINDOW_SIDE (2 * WINDOW_MAX_RADIUS + 1)
+#define WINDOW_OUTSIDE INT_MIN    // Value of window cells that fall off the board
+#define WINDOW_CELL(win, dx, dy) \
+    ((win)->cells[(WINDOW_MAX_RADIUS + (dy)) * WINDOW_SIDE + WINDOW_MAX_RADIUS + (dx)])
+
+/* The master bumps the generation twice (begin and end of write) per move it handles */
+#define GENERATIONS_PER_MOVE 2
+
+/* Attempts made without the reader lock before snapshot_window() falls back to it */
+#define SNAPSHOT_OPTIMISTIC_TRIES 8
+
+typedef struct {
+    unsigned int generation;      // State generation this copy belongs to
+    int center_x, center_y;       // Board coordinates of the window center
+    int radius;                   // Cells farther than this from the center are not filled
+    unsigned short width;         // Board width
+    unsigned short height;        // Board height
+    unsigned int player_count;    // Number of players
+    bool game_over;               // Game over flag at this generation
+    Player players[9];            // Copy of the player table
+    int cells[WINDOW_SIDE * WINDOW_SIDE];
+} BoardWindow;
+
 
 // Functions for shared memory operations
 
@@ -34,6 +63,40 @@ void* open_shared_memory(const char* name, size_t size, int flags);
  */
 void close_shared_memory(void* ptr, const char* name, size_t size);
 
+/**
+ * @brief Tell the master that this process has mapped shared memory and is ready.
+ * @param sync Pointer to the mapped synchronization segment.
+ */
+void signal_ready(GameSync* sync);
+
+/**
+ * @brief Enter the shared state as a reader (readers-writer protocol).
+ * @param sync Pointer to the mapped synchronization segment.
+ */
+void reader_enter(GameSync* sync);
+
+/**
+ * @brief Leave the shared state as a reader.
+ * @param sync Pointer to the mapped synchronization segment.
+ */
+void reader_exit(GameSync* sync);
+
+/**
+ * @brief Copy a consistent window of the board around a player, plus the player table.
+ *
+ * The copy is taken optimistically against the generation counter, without
+ * touching any shared cache line; only if the master keeps writing does it
+ * fall back to the reader lock.
+ * @param state Pointer to the mapped game state.
+ * @param sync Pointer to the mapped synchronization segment.
+ * @param player_idx Player whose position is the window center.
+ * @param radius Window radius in cells (clamped to WINDOW_MAX_RADIUS).
+ * @param out Destination window.
+ * @return The state generation of the copy.
+ */
+unsigned int snapshot_window(const GameState* state, GameSync* sync, int player_idx,
+                             int radius, BoardWindow* out);
+
 /* Convenient aliases for the shared memory segment names */
 #define GAME_STATE_SHM NAME_BOARD
 #define GAME_SYNC_SHM NAME_SYNC
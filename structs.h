@@ -2,16 +2,32 @@
 #define STRUCTS_H
 
 #include <stdlib.h>
+#include <stddef.h>
 #include <semaphore.h>
+#include "sync.h"
 #include <stdbool.h>
 
 /* Shared memory segment names for game state and synchronization */
 #define NAME_BOARD "/game_state"
 #define NAME_SYNC "/game_sync"
 
+/* Every process of a game maps these layouts, so whatever one of them
+ * writes often gets a cache line of its own: a write to one player's
+ * score must not invalidate the line another player's semaphore or the
+ * board header lives on.
+ */
+#define CACHE_LINE_SIZE 64
+
+/* Compile-time check (C99 has no _Static_assert): a false condition
+ * declares an array of negative size.
+ */
+#define STATIC_ASSERT(cond, name) typedef char static_assert_##name[(cond) ? 1 : -1]
+
 
 /* This struct is used to store information about each player
  * including their state, position, and statistics.
+ * Each player fills one cache line; the master only ever writes one
+ * player's line per move.
  */
 typedef struct {
     char name[16];                // Player name
@@ -21,31 +37,50 @@ typedef struct {
     unsigned short x, y;          // Player coordinates on the board
     pid_t pid;                    // Process identifier
     bool is_blocked;              // Indicates if the player is blocked
-} Player;
+} __attribute__((aligned(CACHE_LINE_SIZE))) Player;
 
 /* This struct represents the complete game state including
  * board dimensions, players, and the game board itself.
+ * The read-mostly header shares its line with nothing; the players and
+ * the board each start on a line boundary.
  */
 typedef struct {
     unsigned short width;         // Board width
     unsigned short height;        // Board height
     unsigned int player_count;    // Number of players
-    Player players[9];            // List of players
     bool game_over;               // Indicates if the game has ended
-    int board[];                  // Pointer to the beginning of the board
+    bool pool_closed;             // No game follows this one (pooled players exit, see pool.h)
+    unsigned int game_id;         // Game number within a pooled run, from 0
+    Player players[9];            // List of players
+    int board[] __attribute__((aligned(CACHE_LINE_SIZE))); // Pointer to the beginning of the board
 } GameState;
 
 /* This struct contains all synchronization primitives needed
  * for coordinating between master, players, and view processes.
+ * Every SyncSem is padded to a cache line (see sync.h), so posting one
+ * player's semaphore never touches another's; the reader count and the
+ * seqlock generation get their own lines as well.
  */
 typedef struct {
-    sem_t view_update_sem;        // Master signals view that there are changes to print
-    sem_t view_done_sem;          // View signals master that it finished printing
-    sem_t master_access_mutex;    // Mutex to prevent master starvation when accessing state
-    sem_t game_state_mutex;       // Mutex for the game state
-    sem_t reader_count_mutex;     // Mutex for the next variable
-    unsigned int readers_count;   // Number of players reading the state
-    sem_t player_move_sem[9];     // Signal each player that they can send 1 movement
+    SyncSem view_update_sem;      // Master signals view that there are changes to print
+    SyncSem view_done_sem;        // View signals master that it finished printing
+    SyncSem master_access_mutex;  // Mutex to prevent master starvation when accessing state
+    SyncSem game_state_mutex;     // Mutex for the game state
+    SyncSem reader_count_mutex;   // Mutex for the next variable
+    unsigned int readers_count __attribute__((aligned(CACHE_LINE_SIZE))); // Number of players reading the state
+    SyncSem player_move_sem[9];   // Signal each player that they can send 1 movement
+    SyncSem ready_sem;            // Each child posts once it has mapped shm and is ready
+    unsigned int generation __attribute__((aligned(CACHE_LINE_SIZE))); // State version: odd while the master is writing (seqlock)
 } GameSync;
 
+STATIC_ASSERT(sizeof(Player) == CACHE_LINE_SIZE, player_fills_one_line);
+STATIC_ASSERT(offsetof(GameState, players) % CACHE_LINE_SIZE == 0, players_start_a_line);
+STATIC_ASSERT(offsetof(GameState, board) % CACHE_LINE_SIZE == 0, board_starts_a_line);
+STATIC_ASSERT(sizeof(SyncSem) % CACHE_LINE_SIZE == 0, sync_sem_fills_lines);
+STATIC_ASSERT(offsetof(GameSync, readers_count) % CACHE_LINE_SIZE == 0, readers_count_owns_a_line);
+STATIC_ASSERT(offsetof(GameSync, player_move_sem) - offsetof(GameSync, readers_count) >= CACHE_LINE_SIZE,
+              readers_count_line_is_private);
+STATIC_ASSERT(offsetof(GameSync, generation) % CACHE_LINE_SIZE == 0, generation_owns_a_line);
+STATIC_ASSERT(sizeof(GameSync) - offsetof(GameSync, generation) == CACHE_LINE_SIZE, generation_line_is_private);
+
 #endif // STRUCTS_H
\ No newline at end of file
@@ -0,0 +1,174 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE // For syscall
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#include "sync.h"
+
+#ifdef USE_FUTEX_SYNC
+
+static inline void cpu_relax(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+static unsigned long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static long futex(unsigned int* uaddr, int op, unsigned int val, const struct timespec* ts) {
+    // Shared futex (no FUTEX_PRIVATE_FLAG): the word lives in a MAP_SHARED segment
+    return syscall(SYS_futex, uaddr, op, val, ts, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+static int try_take(FutexSem* s) {
+    unsigned int v = __atomic_load_n(&s->value, __ATOMIC_RELAXED);
+    while (v > 0) {
+        if (__atomic_compare_exchange_n(&s->value, &v, v - 1, 1,
+                                        __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void adjust_budget(FutexSem* s, int spun_ok) {
+    unsigned int budget = __atomic_load_n(&s->spin_budget, __ATOMIC_RELAXED);
+    if (spun_ok) {
+        budget = budget * 2 > SYNC_SPIN_MAX ? SYNC_SPIN_MAX : budget * 2;
+    } else {
+        budget = budget / 2 < SYNC_SPIN_MIN ? SYNC_SPIN_MIN : budget / 2;
+    }
+    __atomic_store_n(&s->spin_budget, budget, __ATOMIC_RELAXED);
+}
+
+static int futex_sem_wait(FutexSem* s, const struct timespec* deadline) {
+    if (try_take(s)) {
+        return 0;
+    }
+
+    // Spin phase: the poster is often only a few hundred cycles away
+    unsigned int budget = __atomic_load_n(&s->spin_budget, __ATOMIC_RELAXED);
+    for (unsigned int i = 0; i < budget; i++) {
+        cpu_relax();
+        if (try_take(s)) {
+            __atomic_fetch_add(&s->spins, 1, __ATOMIC_RELAXED);
+            adjust_budget(s, 1);
+            return 0;
+        }
+    }
+    adjust_budget(s, 0);
+
+    // Park phase
+    int result = 0;
+    __atomic_fetch_add(&s->waiters, 1, __ATOMIC_SEQ_CST);
+    while (!try_take(s)) {
+        __atomic_fetch_add(&s->parks, 1, __ATOMIC_RELAXED);
+        long rc = futex(&s->value, FUTEX_WAIT_BITSET | FUTEX_CLOCK_REALTIME, 0, deadline);
+        if (rc == -1 && (errno == ETIMEDOUT || (errno == EINTR && deadline != NULL))) {
+            if (try_take(s)) {
+                break;
+            }
+            result = -1;
+            break;
+        }
+
+        unsigned long long posted = __atomic_load_n(&s->post_ns, __ATOMIC_RELAXED);
+        unsigned long long now = now_ns();
+        if (rc == 0 && posted != 0 && now > posted) {
+            unsigned long long latency = now - posted;
+            __atomic_fetch_add(&s->wake_latency_ns, latency, __ATOMIC_RELAXED);
+            unsigned long long max = __atomic_load_n(&s->max_wake_latency_ns, __ATOMIC_RELAXED);
+            while (latency > max &&
+                   !__atomic_compare_exchange_n(&s->max_wake_latency_ns, &max, latency, 1,
+                                                __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            }
+        }
+    }
+    __atomic_fetch_sub(&s->waiters, 1, __ATOMIC_SEQ_CST);
+    return result;
+}
+
+void sync_init(SyncSem* s, unsigned int value) {
+    memset(s, 0, sizeof(*s));
+    s->spin_budget = SYNC_SPIN_MIN;
+    __atomic_store_n(&s->value, value, __ATOMIC_RELEASE);
+}
+
+void sync_destroy(SyncSem* s) {
+    (void)s; // Nothing is held outside the shared word
+}
+
+void sync_wait(SyncSem* s) {
+    futex_sem_wait(s, NULL);
+}
+
+int sync_trywait(SyncSem* s) {
+    if (try_take(s)) {
+        return 0;
+    }
+    errno = EAGAIN;
+    return -1;
+}
+
+int sync_timedwait(SyncSem* s, const struct timespec* deadline) {
+    return futex_sem_wait(s, deadline);
+}
+
+void sync_post(SyncSem* s) {
+    __atomic_fetch_add(&s->value, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&s->waiters, __ATOMIC_SEQ_CST) > 0) {
+        __atomic_store_n(&s->post_ns, now_ns(), __ATOMIC_RELAXED);
+        futex(&s->value, FUTEX_WAKE, 1, NULL);
+    }
+}
+
+void sync_stats(SyncSem* s, SyncStats* stats) {
+    stats->spins = __atomic_load_n(&s->spins, __ATOMIC_RELAXED);
+    stats->parks = __atomic_load_n(&s->parks, __ATOMIC_RELAXED);
+    stats->wake_latency_ns = __atomic_load_n(&s->wake_latency_ns, __ATOMIC_RELAXED);
+    stats->max_wake_latency_ns = __atomic_load_n(&s->max_wake_latency_ns, __ATOMIC_RELAXED);
+}
+
+#else // POSIX semaphore backend
+
+void sync_init(SyncSem* s, unsigned int value) {
+    sem_init(&s->sem, 1, value);
+}
+
+void sync_destroy(SyncSem* s) {
+    sem_destroy(&s->sem);
+}
+
+void sync_wait(SyncSem* s) {
+    while (sem_wait(&s->sem) == -1 && errno == EINTR) {
+    }
+}
+
+int sync_trywait(SyncSem* s) {
+    return sem_trywait(&s->sem);
+}
+
+int sync_timedwait(SyncSem* s, const struct timespec* deadline) {
+    return sem_timedwait(&s->sem, deadline);
+}
+
+void sync_post(SyncSem* s) {
+    sem_post(&s->sem);
+}
+
+void sync_stats(SyncSem* s, SyncStats* stats) {
+    (void)s;
+    memset(stats, 0, sizeof(*stats));
+}
+
+#endif // USE_FUTEX_SYNC
@@ -0,0 +1,97 @@
+#ifndef SYNC_H
+#define SYNC_H
+
+#include <semaphore.h>
+#include <time.h>
+
+/* Spin iterations a waiter may burn before parking. The budget adapts per
+ * primitive: it grows when spinning pays off and shrinks when it does not.
+ */
+#define SYNC_SPIN_MIN 8
+#define SYNC_SPIN_MAX 4096
+
+/* Futex-backed counting event living in shared memory. Each one owns a full
+ * cache line so handoffs on different primitives never share a line.
+ * Initialised to 1 it is used as a mutex, exactly like the sem_t it replaces.
+ */
+typedef struct {
+    unsigned int value;                // Futex word: available posts
+    unsigned int waiters;              // Processes parked (or about to park) on value
+    unsigned int spin_budget;          // Current adaptive spin limit
+    unsigned int pad;
+    unsigned long long post_ns;        // Monotonic time of the last post that had waiters
+    unsigned long long spins;          // Acquisitions satisfied while spinning
+    unsigned long long parks;          // Times a waiter went to sleep in the kernel
+    unsigned long long wake_latency_ns;     // Sum of post-to-wakeup latencies
+    unsigned long long max_wake_latency_ns; // Worst post-to-wakeup latency
+} __attribute__((aligned(64))) FutexSem;
+
+/* Counters reported by sync_stats() */
+typedef struct {
+    unsigned long long spins;
+    unsigned long long parks;
+    unsigned long long wake_latency_ns;
+    unsigned long long max_wake_latency_ns;
+} SyncStats;
+
+/* Build with -DUSE_FUTEX_SYNC (make SYNC=futex) to swap every GameSync
+ * semaphore for a FutexSem. All processes of a game must use the same build.
+ */
+#ifdef USE_FUTEX_SYNC
+typedef FutexSem SyncSem;
+#else
+/* A POSIX semaphore padded to its own cache line, like FutexSem */
+typedef struct {
+    sem_t sem;
+} __attribute__((aligned(64))) PaddedSem;
+typedef PaddedSem SyncSem;
+#endif
+
+/**
+ * @brief Initialize a process-shared primitive.
+ * @param s Pointer to the primitive, which must live in shared memory.
+ * @param value Initial count (0 for an event, 1 for a mutex).
+ */
+void sync_init(SyncSem* s, unsigned int value);
+
+/**
+ * @brief Release any resources held by a primitive.
+ * @param s Pointer to the primitive.
+ */
+void sync_destroy(SyncSem* s);
+
+/**
+ * @brief Decrement the count, blocking while it is zero.
+ * @param s Pointer to the primitive.
+ */
+void sync_wait(SyncSem* s);
+
+/**
+ * @brief Decrement the count without blocking.
+ * @param s Pointer to the primitive.
+ * @return 0 on success, -1 with errno set to EAGAIN if the count was zero.
+ */
+int sync_trywait(SyncSem* s);
+
+/**
+ * @brief Decrement the count, blocking at most until an absolute deadline.
+ * @param s Pointer to the primitive.
+ * @param deadline Absolute CLOCK_REALTIME deadline.
+ * @return 0 on success, -1 with errno set to ETIMEDOUT or EINTR otherwise.
+ */
+int sync_timedwait(SyncSem* s, const struct timespec* deadline);
+
+/**
+ * @brief Increment the count, waking one waiter if any.
+ * @param s Pointer to the primitive.
+ */
+void sync_post(SyncSem* s);
+
+/**
+ * @brief Read the spin/park/latency counters of a primitive.
+ * @param s Pointer to the primitive.
+ * @param stats Output counters; all zero for the sem_t backend.
+ */
+void sync_stats(SyncSem* s, SyncStats* stats);
+
+#endif // SYNC_H
@@ -0,0 +1,216 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "trace.h"
+
+typedef enum {
+    TRACE_SPAN,
+    TRACE_FLOW_START,
+    TRACE_FLOW_END,
+    TRACE_THREAD_NAME
+} TraceKind;
+
+typedef struct {
+    const char* name;          // Literal: span, flow or thread name
+    unsigned long long ts_ns;
+    unsigned long long dur_ns;
+    unsigned long long id;     // Move sequence number of a span, or flow id
+    int tid;
+    int kind;
+} TraceEvent;
+
+bool trace_enabled = false;
+
+static TraceEvent* events = NULL;
+static unsigned long capacity = 0;
+static unsigned long claimed = 0;   // Slots handed out, drops included
+static char process_name[32];
+static char path[256];
+static __thread int cached_tid = 0;
+
+static int current_tid(void) {
+    if (cached_tid == 0) {
+        cached_tid = (int)syscall(SYS_gettid);
+    }
+    return cached_tid;
+}
+
+static void record(int kind, int tid, const char* name, unsigned long long ts_ns,
+                   unsigned long long dur_ns, unsigned long long id) {
+    if (!trace_enabled) {
+        return;
+    }
+    unsigned long slot = __atomic_fetch_add(&claimed, 1, __ATOMIC_RELAXED);
+    if (slot >= capacity) {
+        return; // Full: counted as dropped by claimed - capacity
+    }
+    events[slot].name = name;
+    events[slot].ts_ns = ts_ns;
+    events[slot].dur_ns = dur_ns;
+    events[slot].id = id;
+    events[slot].tid = tid;
+    events[slot].kind = kind;
+}
+
+void trace_init(const char* name) {
+    const char* target = getenv(TRACE_ENV);
+    const char* size = getenv(TRACE_ENV_EVENTS);
+    
+    if (target == NULL || target[0] == '\0') {
+        return;
+    }
+    capacity = size != NULL ? strtoul(size, NULL, 10) : TRACE_DEFAULT_EVENTS;
+    events = calloc(capacity, sizeof(TraceEvent));
+    if (events == NULL) {
+        perror("trace");
+        return;
+    }
+    snprintf(process_name, sizeof(process_name), "%s", name);
+    snprintf(path, sizeof(path), "%s", target);
+    claimed = 0;
+    trace_enabled = true;
+}
+
+unsigned long long trace_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void trace_span(const char* name, unsigned long long start_ns, unsigned long long end_ns,
+                unsigned long long seq) {
+    record(TRACE_SPAN, current_tid(), name, start_ns, end_ns - start_ns, seq);
+}
+
+void trace_track_span(int track, const char* name, unsigned long long start_ns,
+                      unsigned long long end_ns, unsigned long long seq) {
+    record(TRACE_SPAN, TRACE_TRACK_BASE + track, name, start_ns, end_ns - start_ns, seq);
+}
+
+void trace_flow(const char* name, bool start, unsigned long long id, unsigned long long ts_ns) {
+    record(start ? TRACE_FLOW_START : TRACE_FLOW_END, current_tid(), name, ts_ns, 0, id);
+}
+
+void trace_name_thread(const char* name) {
+    record(TRACE_THREAD_NAME, current_tid(), name, 0, 0, 0);
+}
+
+void trace_name_track(int track, const char* name) {
+    record(TRACE_THREAD_NAME, TRACE_TRACK_BASE + track, name, 0, 0, 0);
+}
+
+/* Chrome trace events separated by sep (a newline in dumps, a comma and a
+ * newline in the merged file)
+ */
+static void write_events(FILE* out, const char* sep) {
+    int pid = getpid();
+    unsigned long count = claimed < capacity ? claimed : capacity;
+    
+    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"%s\"}}",
+            pid, process_name);
+    for (unsigned long i = 0; i < count; i++) {
+        const TraceEvent* e = &events[i];
+        fputs(sep, out);
+        switch (e->kind) {
+            case TRACE_SPAN:
+                fprintf(out, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,"
+                        "\"dur\":%.3f,\"args\":{\"seq\":%llu}}",
+                        e->name, pid, e->tid, e->ts_ns / 1000.0, e->dur_ns / 1000.0, e->id);
+                break;
+            case TRACE_FLOW_START:
+            case TRACE_FLOW_END:
+                fprintf(out, "{\"name\":\"%s\",\"cat\":\"flow\",\"ph\":\"%s\",\"id\":%llu,"
+                        "\"pid\":%d,\"tid\":%d,\"ts\":%.3f}",
+                        e->name, e->kind == TRACE_FLOW_START ? "s" : "f\",\"bp\":\"e", e->id,
+                        pid, e->tid, e->ts_ns / 1000.0);
+                break;
+            default:
+                fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                        "\"args\":{\"name\":\"%s\"}}", pid, e->tid, e->name);
+                break;
+        }
+    }
+}
+
+static unsigned long dropped(void) {
+    return claimed > capacity ? claimed - capacity : 0;
+}
+
+void trace_finish(void) {
+    char dump[sizeof(path) + 16];
+    
+    if (!trace_enabled) {
+        return;
+    }
+    trace_enabled = false;
+    snprintf(dump, sizeof(dump), "%s.%d", path, (int)getpid());
+    FILE* out = fopen(dump, "w");
+    if (out == NULL) {
+        perror(dump);
+        return;
+    }
+    write_events(out, "\n");
+    fputs("\n", out);
+    fclose(out);
+    if (dropped() > 0) {
+        fprintf(stderr, "trace: %s dropped %lu events (raise %s)\n", process_name, dropped(),
+                TRACE_ENV_EVENTS);
+    }
+}
+
+/* Copy a child's dump into the merged array and remove it */
+static bool append_dump(FILE* out, pid_t pid) {
+    char dump[sizeof(path) + 16];
+    char line[512];              // Events are short: names are literals
+    
+    snprintf(dump, sizeof(dump), "%s.%d", path, (int)pid);
+    FILE* in = fopen(dump, "r");
+    if (in == NULL) {
+        return false;
+    }
+    while (fgets(line, sizeof(line), in) != NULL) {
+        line[strcspn(line, "\n")] = '\0';
+        if (line[0] != '\0') {
+            fprintf(out, ",\n%s", line);
+        }
+    }
+    fclose(in);
+    unlink(dump);
+    return true;
+}
+
+void trace_merge(const pid_t* pids, int count) {
+    char tmp[sizeof(path) + 16];
+    int merged = 0;
+    
+    if (!trace_enabled) {
+        return;
+    }
+    trace_enabled = false;
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* out = fopen(tmp, "w");
+    if (out == NULL) {
+        perror(tmp);
+        return;
+    }
+    
+    fputs("{\"traceEvents\":[\n", out);
+    write_events(out, ",\n");
+    for (int i = 0; i < count; i++) {
+        merged += append_dump(out, pids[i]);
+    }
+    fputs("\n]}\n", out);
+    fclose(out);
+    if (rename(tmp, path) != 0) {
+        perror(path);
+        return;
+    }
+    
+    printf("trace: %s (%d processes merged, %lu master events dropped)\n", path, merged + 1, dropped());
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <sys/types.h>
+
+/* Opt-in tracing of the move pipeline. The master's -T sets TRACE_ENV; the
+ * master, the view and player_simple then record spans into a private
+ * buffer. At exit each child dumps its buffer next to the trace file and
+ * the master merges everything into one Chrome trace (JSON), viewable in
+ * chrome://tracing or Perfetto. All timestamps are CLOCK_MONOTONIC, which
+ * every process on the machine shares.
+ */
+#define TRACE_ENV "CHOMP_TRACE"                 // Path of the merged trace
+#define TRACE_ENV_EVENTS "CHOMP_TRACE_EVENTS"   // Events kept per process
+#define TRACE_DEFAULT_EVENTS 131072             // About 5 MB per process
+#define TRACE_TRACK_BASE 1000000000             // Thread ids of virtual tracks (above any real tid)
+
+/* Whether trace_init() enabled tracing; every trace call is a no-op otherwise */
+extern bool trace_enabled;
+
+/* Flow ids tying the spans of one move together across processes: a
+ * player's move is its n-th (valid + invalid moves so far), a frame is
+ * identified by the total number of moves the master had handled.
+ */
+#define TRACE_MOVE_FLOW(player, seq) ((((unsigned long long)(player) + 1) << 32) | (seq))
+#define TRACE_FRAME_FLOW(moves) ((1ULL << 40) | (moves))
+
+/* Current time for a span, 0 (and no clock read) when tracing is off */
+#define TRACE_NOW() (trace_enabled ? trace_clock_ns() : 0ULL)
+
+/**
+ * @brief Read TRACE_ENV and, if set, allocate this process's event buffer.
+ * @param process_name Name shown for this process in the trace.
+ */
+void trace_init(const char* process_name);
+
+/**
+ * @brief CLOCK_MONOTONIC in nanoseconds.
+ * @return Current time.
+ */
+unsigned long long trace_clock_ns(void);
+
+/**
+ * @brief Record a completed span on the calling thread.
+ *
+ * Lock-free: a slot is claimed with one atomic add. When the buffer is
+ * full the span is dropped and counted.
+ * @param name Span name; must be a literal.
+ * @param start_ns Start, from TRACE_NOW().
+ * @param end_ns End, from TRACE_NOW().
+ * @param seq Move sequence number shown with the span.
+ */
+void trace_span(const char* name, unsigned long long start_ns, unsigned long long end_ns,
+                unsigned long long seq);
+
+/**
+ * @brief Record a completed span on a virtual track of this process.
+ * @param track Track number, named with trace_name_track().
+ * @param name Span name; must be a literal.
+ * @param start_ns Start time.
+ * @param end_ns End time.
+ * @param seq Move sequence number shown with the span.
+ */
+void trace_track_span(int track, const char* name, unsigned long long start_ns,
+                      unsigned long long end_ns, unsigned long long seq);
+
+/**
+ * @brief Start or finish a flow arrow on the calling thread.
+ *
+ * A flow attaches to the span enclosing ts_ns on the same thread, so record
+ * it with a timestamp inside that span.
+ * @param name Flow name; must be a literal.
+ * @param start true for the source end, false for the destination.
+ * @param id Flow id, from TRACE_MOVE_FLOW() or TRACE_FRAME_FLOW().
+ * @param ts_ns Time of the flow point.
+ */
+void trace_flow(const char* name, bool start, unsigned long long id, unsigned long long ts_ns);
+
+/**
+ * @brief Name the calling thread in the trace.
+ * @param name Thread name; must be a literal.
+ */
+void trace_name_thread(const char* name);
+
+/**
+ * @brief Name a virtual track in the trace.
+ * @param track Track number.
+ * @param name Track name; must be a literal.
+ */
+void trace_name_track(int track, const char* name);
+
+/**
+ * @brief Dump this process's events next to the trace file for the master to merge.
+ */
+void trace_finish(void);
+
+/**
+ * @brief Write the trace file: this process's events plus the children's dumps.
+ *
+ * Call once the children have exited. Dumps are removed after merging; a
+ * child that left none (killed, or not traced) is skipped.
+ * @param pids Children whose dumps to merge.
+ * @param count Number of pids.
+ */
+void trace_merge(const pid_t* pids, int count);
+
+#endif // TRACE_H
\ No newline at end of file
@@ -8,13 +8,34 @@
 #include <signal.h>
 #include <sys/mman.h>
 #include <fcntl.h> 
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <errno.h>
 #include "sharedMem.h"
+#include "trace.h"
+#include "render.h"
+#include "frames.h"
+#include "rt.h"
 
 GameState* game_state = NULL;
 GameSync* game_sync = NULL;
 size_t game_state_size = 0;
+char* frame_buffer = NULL;
+size_t frame_buffer_size = 0;
+FrameWriter frame_writer;
+bool binary_output = false;
+bool recording_stopped = false;  // The frame stream failed; frames are still acknowledged
+RenderView view_state = {0, 0, 0, 0, 1, 1, false, 0}; // Follows player 0 by default
+struct termios saved_termios;
+bool keyboard_enabled = false;
+
+#define KEY_ESCAPE 27
 
 void display_game_state();
+unsigned long long frame_moves();
+void setup_keyboard();
+void handle_keys();
+void restore_terminal();
 void cleanup();
 void sig_handler(int signo);
 
@@ -29,6 +50,7 @@ int main(int argc, char* argv[]) {
     
     signal(SIGINT, sig_handler);
     signal(SIGTERM, sig_handler);
+    signal(SIGPIPE, SIG_IGN); // A FIFO reader that leaves shows up as EPIPE instead
     
     game_state_size = sizeof(GameState) + width * height * sizeof(int);
     
@@ -62,107 +84,195 @@ int main(int argc, char* argv[]) {
     }
     close(fd_sync);
     
+    // VISTA_OUTPUT selects the binary frame stream instead of ANSI text
+    const char* output_path = getenv("VISTA_OUTPUT");
+    if (output_path != NULL) {
+        const char* keyframe = getenv("VISTA_KEYFRAME");
+        if (frame_writer_open(&frame_writer, output_path, game_state,
+                              keyframe != NULL ? atoi(keyframe) : FRAMES_DEFAULT_KEYFRAME) != 0) {
+            cleanup();
+            exit(EXIT_FAILURE);
+        }
+        binary_output = true;
+    }
+    
+    frame_buffer_size = render_buffer_size(width, height, game_state->player_count);
+    frame_buffer = malloc(frame_buffer_size);
+    if (frame_buffer == NULL) {
+        perror("malloc frame buffer");
+        cleanup();
+        exit(EXIT_FAILURE);
+    }
+    
+    if (!binary_output) {
+        setup_keyboard();
+    }
+    
+    trace_init("view");
+    
+    // Low-jitter mode requested through the master's -R
+    if (rt_mode() != RT_OFF) {
+        rt_prefault(game_state, game_state_size);
+        rt_prefault(game_sync, sizeof(GameSync));
+        rt_enter(RT_PRIORITY_CHILD);
+    }
+    
+    signal_ready(game_sync);
+    
     while (!game_state->game_over) {
-        sem_wait(&game_sync->view_update_sem);
+        unsigned long long wait_ns = TRACE_NOW();
+        sync_wait(&game_sync->view_update_sem);
+        unsigned long long frame_ns = TRACE_NOW();
+        unsigned long long moves = frame_moves();
+        trace_span("wait_update", wait_ns, frame_ns, moves);
+        trace_flow("frame", false, TRACE_FRAME_FLOW(moves), frame_ns);
         display_game_state();
-        sem_post(&game_sync->view_done_sem);
+        trace_span("render", frame_ns, TRACE_NOW(), moves);
+        sync_post(&game_sync->view_done_sem);
     }
 
     display_game_state();
-    sem_post(&game_sync->view_done_sem);
+    sync_post(&game_sync->view_done_sem);
 
     cleanup();
     return 0;
 }
 
-void display_game_state() {
-    int width = game_state->width;
-    int height = game_state->height;
-    int player_count = game_state->player_count;
-
-        const char* player_colors[] = {
-        "\033[31m",  // Red
-        "\033[34m",  // Blue
-        "\033[35m",  // Magenta
-        "\033[36m",  // Cyan
-        "\033[33m",  // Yellow
-        "\033[97m",  // White
-        "\033[37;44m", // White on blue
-        "\033[37;45m", // White on magenta
-        "\033[37;46m"  // White on cyan
-    };
+/* Moves the master has handled, which is how it numbers the frame it asked for */
+unsigned long long frame_moves() {
+    unsigned long long moves = 0;
+    for (unsigned int i = 0; i < game_state->player_count; i++) {
+        moves += game_state->players[i].valid_moves + game_state->players[i].invalid_moves;
+    }
+    return moves;
+}
 
-    printf("\033[2J\033[H");
+void display_game_state() {
+    if (recording_stopped) {
+        return;
+    }
+    if (binary_output) {
+        // The master waits for every frame, so a failed stream must not end the view
+        if (frame_writer_write(&frame_writer, game_state) != 0) {
+            fprintf(stderr, "View: frame stream %s, recording stopped\n",
+                    errno == EPIPE ? "reader left" : strerror(errno));
+            frame_writer_close(&frame_writer);
+            binary_output = false;
+            recording_stopped = true;
+        }
+        return;
+    }
     
-    printf("===== ChompChamps =====\n");
-    printf("Game Status: %s\n", game_state->game_over ? "GAME OVER" : "IN PROGRESS");
-    printf("\n");
+    struct winsize ws;
+    size_t len;
     
-    printf("Players:\n");
-    for (int i = 0; i < player_count; i++) {
-        printf("\033%s[%d] %s - Score: %u, Position: (%u,%u), Valid Moves: %u, Invalid Moves: %u, %s\033[0m\n",
-              player_colors[i % 9], i, game_state->players[i].name, game_state->players[i].score,
-              game_state->players[i].x, game_state->players[i].y,
-              game_state->players[i].valid_moves, game_state->players[i].invalid_moves,
-              game_state->players[i].is_blocked ? "BLOCKED" : "ACTIVE");
+    handle_keys();
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0 && ws.ws_row > 0) {
+        render_view_fit(&view_state, game_state, ws.ws_col, ws.ws_row);
+        len = render_viewport(game_state, &view_state, frame_buffer, frame_buffer_size);
+    } else {
+        // Not a terminal (file or pipe): keep the whole board
+        len = render_game_state(game_state, frame_buffer, frame_buffer_size);
     }
-    printf("\n");
     
-    printf("Board:\n");
-    printf("   ");
-    for (int x = 0; x < width; x++) {
-        printf("%2d ", x);
+    // One vectorized pass over the whole board, even when only a viewport is shown
+    BoardStats stats;
+    board_stats(game_state->board, (size_t)game_state->width * game_state->height, &stats);
+    len += render_stats(&stats, game_state->player_count, frame_buffer + len, frame_buffer_size - len);
+    fwrite(frame_buffer, 1, len, stdout);
+    fflush(stdout);
+}
+
+/* Keys (read between frames, without blocking):
+ *   arrows / hjkl  scroll the viewport (stops following)
+ *   0-8            follow that player
+ *   n              follow the next player
+ *   o              toggle the downsampled overview
+ */
+void setup_keyboard() {
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &saved_termios) == -1) {
+        return;
     }
-    printf("\n");
     
-    for (int y = 0; y < height; y++) {
-        printf("%2d ", y);
-        for (int x = 0; x < width; x++) {
-            int cell_value = game_state->board[y * width + x];
+    struct termios raw = saved_termios;
+    raw.c_lflag &= ~(ICANON | ECHO);
+    raw.c_cc[VMIN] = 0;   // read() returns at once when no key is pending
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSANOW, &raw) == 0) {
+        keyboard_enabled = true;
+        atexit(restore_terminal); // Every exit() path, including perror + exit, gives the tty back
+    }
+}
+
+static void scroll_view(int dx, int dy) {
+    int step_x = view_state.cols / 4 > 0 ? view_state.cols / 4 : 1;
+    int step_y = view_state.rows / 4 > 0 ? view_state.rows / 4 : 1;
+    
+    view_state.follow = -1;
+    view_state.origin_x += dx * step_x;
+    view_state.origin_y += dy * step_y;
+}
+
+void handle_keys() {
+    unsigned char keys[32];
+    ssize_t n;
+    
+    if (!keyboard_enabled) {
+        return;
+    }
+    
+    while ((n = read(STDIN_FILENO, keys, sizeof(keys))) > 0) {
+        for (ssize_t i = 0; i < n; i++) {
+            unsigned char key = keys[i];
             
-            bool player_present = false;
-            for (int i = 0; i < player_count; i++) {
-                if (game_state->players[i].x == x && game_state->players[i].y == y) {
-                    player_present = true;
-                    break;
-                }
+            // Arrow keys arrive as ESC [ A..D
+            if (key == KEY_ESCAPE && i + 2 < n && keys[i + 1] == '[') {
+                key = keys[i + 2];
+                i += 2;
+                key = key == 'A' ? 'k' : key == 'B' ? 'j' : key == 'C' ? 'l' : key == 'D' ? 'h' : 0;
             }
             
-            if (player_present) {
-                printf("\033[1;33m # \033[0m");
-                
-            } else if (cell_value > 0) { 
-                printf("\033[32m%2d \033[0m", cell_value);
-
-            } else {
-                int owner = -cell_value;
-
-                if (owner >= 0 && owner <= player_count) { 
-
-                    printf("%s%2d \033[0m", player_colors[owner % 9], owner);
-
-                } else {
-                    printf("\033[31m ? \033[0m");
-                }
+            if (key >= '0' && key <= '8' && key - '0' < (int)game_state->player_count) {
+                view_state.follow = key - '0';
+            } else if (key == 'n') {
+                view_state.follow = (view_state.follow + 1) % game_state->player_count;
+            } else if (key == 'o') {
+                view_state.overview = !view_state.overview;
+            } else if (key == 'h') {
+                scroll_view(-1, 0);
+            } else if (key == 'l') {
+                scroll_view(1, 0);
+            } else if (key == 'k') {
+                scroll_view(0, -1);
+            } else if (key == 'j') {
+                scroll_view(0, 1);
             }
         }
-        printf("\n");
     }
-   
-    printf("\nLegend:\n");
-    printf("\033[32m1-9\033[0m - Reward value\n");
-    
-    for (int i = 0; i < player_count && i < 9; i++) {
-        printf("%s%2d \033[0m - Player %d's captured cells\n", 
-               player_colors[i % 9], i, i);
+}
+
+/* Puts the tty back in the mode it had before setup_keyboard(). Only calls
+ * tcsetattr(), which is async-signal-safe, so sig_handler() runs it first.
+ */
+void restore_terminal() {
+    if (keyboard_enabled) {
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved_termios);
+        keyboard_enabled = false;
     }
-    
-    printf("\033[1;33m # \033[0m - Player's current position\n");
-    
-    fflush(stdout);
 }
 
 void cleanup() {
+    trace_finish();
+    restore_terminal();
+    
+    if (binary_output) {
+        frame_writer_close(&frame_writer);
+        binary_output = false;
+    }
+    
+    free(frame_buffer);
+    frame_buffer = NULL;
+    
     if (game_state != NULL) {
         munmap(game_state, game_state_size);
         game_state = NULL;
@@ -175,6 +285,7 @@ void cleanup() {
 }
 
 void sig_handler(int signo) {
+    restore_terminal();
     printf("View received signal %d. Cleaning up and exiting...\n", signo);
     cleanup();
     exit(EXIT_SUCCESS);
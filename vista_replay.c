@@ -0,0 +1,71 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "frames.h"
+#include "render.h"
+
+// Offline renderer for the binary frame streams written by vista.
+
+#define DEFAULT_REPLAY_DELAY 100
+
+int main(int argc, char* argv[]) {
+    int delay = DEFAULT_REPLAY_DELAY;
+    bool final_only = false;
+    int opt;
+    
+    while ((opt = getopt(argc, argv, "d:f")) != -1) {
+        switch (opt) {
+            case 'd':
+                delay = atoi(optarg);
+                break;
+            case 'f':
+                final_only = true;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-d delay_ms] [-f] frames_file\n", argv[0]);
+                exit(EXIT_FAILURE);
+        }
+    }
+    if (optind != argc - 1) {
+        fprintf(stderr, "Usage: %s [-d delay_ms] [-f] frames_file\n", argv[0]);
+        exit(EXIT_FAILURE);
+    }
+    
+    FrameReader reader;
+    if (frame_reader_open(&reader, argv[optind]) != 0) {
+        exit(EXIT_FAILURE);
+    }
+    
+    size_t capacity = render_buffer_size(reader.state->width, reader.state->height, 9);
+    char* buffer = malloc(capacity);
+    if (buffer == NULL) {
+        perror("malloc");
+        frame_reader_close(&reader);
+        exit(EXIT_FAILURE);
+    }
+    
+    int rc;
+    unsigned int frames = 0;
+    while ((rc = frame_reader_next(&reader)) == 1) {
+        frames++;
+        if (!final_only) {
+            fwrite(buffer, 1, render_game_state(reader.state, buffer, capacity), stdout);
+            fflush(stdout);
+            usleep(delay * 1000);
+        }
+    }
+    
+    if (final_only && frames > 0) {
+        fwrite(buffer, 1, render_game_state(reader.state, buffer, capacity), stdout);
+    }
+    if (rc < 0) {
+        fprintf(stderr, "Malformed frame after %u frames\n", frames);
+    }
+    
+    free(buffer);
+    frame_reader_close(&reader);
+    return rc < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}